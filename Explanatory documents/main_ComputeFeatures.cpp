@@ -56,12 +56,34 @@
 
 #include "nonFree/sift/SIFT_describer_io.hpp"//SIFT特征描述器IO
 
+#include "../Products/akaze_row_block_describer.hpp"//行块并行非线性尺度空间的AKAZE描述器
+#include "../Products/bounded_queue.hpp"//流水线各阶段之间的有界队列
+#include "../Products/compact_descriptors.hpp"//紧凑描述子编码（RootSIFT uint8、PCA64 uint8）
+#include "../Products/feature_extraction_budget.hpp"//线程与内存预算
+#include "../Products/image_buffer_pool.hpp"//跨图像复用的图像缓冲池
+#include "../Products/image_pyramid_cache.hpp"//列图阶段写出的灰度金字塔缓存
+#include "../Products/image_tiles.hpp"//按mask跳过被遮挡的图块
+#include "../Products/keypoint_selection.hpp"//空间均匀的前K个关键点
+#include "../Products/regions_pack.hpp"//所有视图共用的区域容器文件
+#include "../Products/regions_prefix_provider.hpp"//排序标记和.feat数量头（抢占式匹配只读取前N个区域）
+#include "../Products/sift_anatomy_simd_describer.hpp"//SIMD高斯模糊的SIFT_Anatomy描述器
+#include "../Products/sfm_data_indexed_io.hpp"//索引二进制SfM_Data（.ibin）的读取
+#include "../Products/system_resources.hpp"//核心数与可用内存
+
 #include <cereal/details/helpers.hpp>//cereal辅助库
 
+#include <algorithm>
 #include <atomic>//c++原子操作类型
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef OPENMVG_USE_OPENMP//检查是否定义了名为 OPENMVG_USE_OPENMP 的宏
 #include <omp.h>//openMP库
@@ -89,6 +111,62 @@ features::EDESCRIBER_PRESET stringToEnum(const std::string & sPreset)//将传入
   return preset;
 }
 
+/// 构建随机访问的视图表，并按最长处理时间优先（LPT）排序：
+/// 特征提取的耗时大致与像素数成正比，先处理大图，避免最后一张大图拖住单个线程；
+/// 像素数相同时按视图ID排序，保证顺序稳定
+std::vector<const View *> BuildViewSchedule(const SfM_Data & sfm_data)
+{
+  std::vector<const View *> view_table;
+  view_table.reserve(sfm_data.GetViews().size());
+  for (const auto & view_it : sfm_data.GetViews())
+    view_table.push_back(view_it.second.get());
+
+  std::stable_sort(view_table.begin(), view_table.end(),
+    [](const View * a, const View * b)
+    {
+      return static_cast<std::uint64_t>(a->ui_width) * a->ui_height
+           > static_cast<std::uint64_t>(b->ui_width) * b->ui_height;
+    });
+  return view_table;
+}
+
+/// 流水线中解码阶段的输出：灰度图像及其mask（全局mask为所有视图共享的只读图像）
+struct DecodedView
+{
+  std::string sView_filename, sFeat, sDesc;
+  Image<unsigned char> imageGray;
+  std::shared_ptr<const Image<unsigned char>> mask;
+  std::uint64_t reserved_memory = 0;// 准入控制为该图像预留的内存
+};
+
+/// 流水线中描述阶段的输出：待保存的特征和描述符
+struct DescribedView
+{
+  std::string sView_filename, sFeat, sDesc;
+  std::unique_ptr<Regions> regions;
+};
+
+/// 流水线阶段：工作线程数和累计的忙碌时间（不含在队列上的等待），用于统计占用率
+struct PipelineStage
+{
+  const char * name;
+  unsigned int workers;
+  std::atomic<std::int64_t> busy_us{0};
+
+  PipelineStage(const char * stage_name, unsigned int worker_count)
+    : name(stage_name), workers(worker_count)
+  {}
+
+  template <typename Functor>
+  void Run(Functor && functor)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    functor();
+    busy_us += std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  }
+};
+
 /// - 计算视图图像描述（特征和描述符提取）
 /// - 导出计算数据
 int main(int argc, char **argv)
@@ -101,10 +179,16 @@ int main(int argc, char **argv)
   std::string sImage_Describer_Method = "SIFT";//特征描述方法，默认为SIFT
   bool bForce = false;// 是否强制重新计算特征
   std::string sFeaturePreset = "";// 特征预设
-
-#ifdef OPENMVG_USE_OPENMP
-  int iNumThreads = 0;// 线程数，用于OpenMP并行计算
-#endif
+  std::string sPyramidCacheDir = "";// 灰度金字塔缓存目录（SfMInit_ImageListing -P 输出的 pyramid_cache）
+
+  int iNumThreads = 0;// 并行描述的图像数（0：按核心数和可用内存自动确定）
+  int iMemoryBudget = 0;// 在途图像的内存预算（MiB，0：可用内存的80%）
+  int iTileSize = 0;// 分块描述的图块大小（像素，0：不分块）
+  bool bBufferPool = true;// 是否复用图像缓冲（0：每幅图像重新分配，用于对比）
+  std::string sDescriptorEncoding = "RAW";// 描述子编码：RAW、ROOTSIFT_U8、PCA64
+  bool bSortRegions = false;// 按得分降序写出区域，抢占式匹配只需读取前N个（默认按检测顺序写出）
+  int iMaxFeatures = 0;// 每幅图像最多保留的关键点数（0：全部保留）
+  bool bPackRegions = false;// 是否把所有视图的区域写入一个容器文件（regions.pack），而不是每个视图一对.feat/.desc
   
   // 添加命令行选项
   
@@ -117,10 +201,16 @@ int main(int argc, char **argv)
   cmd.add( make_option('u', bUpRight, "upright") );//'u' 是否使用 upright 特征（bUpRight），默认为 false
   cmd.add( make_option('f', bForce, "force") );//'f' 是否强制重新计算特征（bForce），默认为 false
   cmd.add( make_option('p', sFeaturePreset, "describerPreset") );//'p' 特征预设（sFeaturePreset），用于指定特征提取的详细程度
+  cmd.add( make_option('c', sPyramidCacheDir, "pyramid_cache") );//'c' 灰度金字塔缓存目录，命中时直接映射解码后的像素
 
-#ifdef OPENMVG_USE_OPENMP
   cmd.add( make_option('n', iNumThreads, "numThreads") );
-#endif
+  cmd.add( make_option('M', iMemoryBudget, "memory_budget") );
+  cmd.add( make_option('T', iTileSize, "tile_size") );
+  cmd.add( make_option('b', bBufferPool, "buffer_pool") );
+  cmd.add( make_option('k', bPackRegions, "pack_regions") );
+  cmd.add( make_option('e', sDescriptorEncoding, "descriptor_encoding") );
+  cmd.add( make_option('K', iMaxFeatures, "max_features") );
+  cmd.add( make_option('s', bSortRegions, "sort_regions") );
 
   try {
       // 处理命令行参数
@@ -151,9 +241,33 @@ int main(int argc, char **argv)
         << "   NORMAL (default),\n"
         << "   HIGH,\n"
         << "   ULTRA: !!Can take long time!!\n"
-#ifdef OPENMVG_USE_OPENMP
-        << "[-n|--numThreads] number of parallel computations\n"
-#endif
+        << "[-c|--pyramid_cache] grayscale pyramid cache directory written by the image listing\n"
+        << "[-n|--numThreads] number of images described in parallel\n"
+        << "  (default 0: one per core, limited by the available memory;\n"
+        << "   the remaining cores are used inside the describer)\n"
+        << "[-M|--memory_budget] memory (MiB) of the images being described,\n"
+        << "  an image only starts when its estimated peak memory fits (default 0: 80% of the available memory)\n"
+        << "[-T|--tile_size] describe the images larger than tile_size pixels on overlapping tiles\n"
+        << "  (border: tile_size / 4), for gigapixel & orthophoto inputs (default 0: disabled);\n"
+        << "  the tiles of an image are described in parallel, so a few large images use all the cores\n"
+        << "[-b|--buffer_pool] reuse the image buffers from one image to the next 0 or 1 (default 1)\n"
+        << "[-k|--pack_regions] write the regions of all the views in one container (regions.pack)\n"
+        << "  instead of one .feat/.desc pair per view 0 or 1 (default 0)\n"
+        << "[-e|--descriptor_encoding] (compact descriptors, SIFT & SIFT_ANATOMY)\n"
+        << "   RAW (default),\n"
+        << "   ROOTSIFT_U8: RootSIFT quantized on uint8 (128 bytes),\n"
+        << "   PCA64: RootSIFT projected on 64 principal components learnt on a sample of the images,\n"
+        << "     quantized on uint8 (64 bytes; the projection is stored in image_describer.json)\n"
+        << "[-K|--max_features] keep at most K keypoints per image, spread uniformly over the image\n"
+        << "  (grid bucketing; default 0: keep all). SIFT_ANATOMY selects the keypoints with the\n"
+        << "  strongest detector response before their description (not with -T): an image with more\n"
+        << "  than K keypoints builds its scale space twice (the blur is the main extraction cost),\n"
+        << "  an image under K is described in one pass; the other describers keep the coarsest\n"
+        << "  keypoints of each cell after the description\n"
+        << "[-s|--sort_regions] write the regions sorted by decreasing score (detector response for\n"
+        << "  SIFT_ANATOMY, keypoint scale otherwise), so that the\n"
+        << "  preemptive matching reads only the first N regions 0 or 1 (default 0; the order is recorded\n"
+        << "  in image_describer.json and kept when the extraction is resumed)\n"
       ;
 
       OPENMVG_LOG_ERROR << s;//输出错误信息
@@ -170,11 +284,25 @@ int main(int argc, char **argv)
     << "--upright " << bUpRight << "\n"
     << "--describerPreset " << (sFeaturePreset.empty() ? "NORMAL" : sFeaturePreset) << "\n" //用户选择的描述子预设值，默认为NORMAL
     << "--force " << bForce << "\n"
-#ifdef OPENMVG_USE_OPENMP
-    << "--numThreads " << iNumThreads << "\n" //使用OpenMP进行并行计算时的线程数量
-#endif
+    << "--pyramid_cache " << sPyramidCacheDir << "\n"
+    << "--numThreads " << iNumThreads << "\n" //并行描述的图像数
+    << "--memory_budget " << iMemoryBudget << "\n"
+    << "--tile_size " << iTileSize << "\n"
+    << "--buffer_pool " << bBufferPool << "\n"
+    << "--pack_regions " << bPackRegions << "\n"
+    << "--descriptor_encoding " << sDescriptorEncoding << "\n"
+    << "--max_features " << iMaxFeatures << "\n"
+    << "--sort_regions " << bSortRegions << "\n"
     ;
 
+  // 解析描述子编码
+  EDescriptorEncoding descriptor_encoding = EDescriptorEncoding::RAW;
+  if (!StringToDescriptorEncoding(sDescriptorEncoding, descriptor_encoding))
+  {
+    OPENMVG_LOG_ERROR << "Unknown descriptor encoding: " << sDescriptorEncoding;
+    return EXIT_FAILURE;
+  }
+
   // 检查输出目录
   if (sOutDir.empty())//输出目录是否为空
   {
@@ -198,7 +326,7 @@ int main(int argc, char **argv)
   SfM_Data sfm_data;
   //从指定的文件路径sSfM_Data_Filename加载一个SfM数据对象sfm_data
   
-  if (!Load(sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS|INTRINSICS))) {
+  if (!LoadSfMData(sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS|INTRINSICS))) {//同时支持列图阶段写出的索引二进制格式（.ibin）
     OPENMVG_LOG_ERROR
       << "The input file \""<< sSfM_Data_Filename << "\" cannot be read";
     return EXIT_FAILURE;
@@ -231,6 +359,25 @@ int main(int argc, char **argv)
         << "Cannot dynamically allocate the Image_describer interface.";
       return EXIT_FAILURE;
     }
+    // 续算沿用已保存描述器的描述子编码：显式指定了不同的编码时报错，避免同一目录中混杂两种编码的区域文件
+    const Compact_Image_describer * stored_compact = dynamic_cast<const Compact_Image_describer *>(image_describer.get());
+    const EDescriptorEncoding stored_encoding = stored_compact ? stored_compact->Encoding() : EDescriptorEncoding::RAW;
+    if (cmd.used('e') && stored_encoding != descriptor_encoding)
+    {
+      OPENMVG_LOG_ERROR << "The regions of " << sOutDir << " use the descriptor encoding "
+        << DescriptorEncodingToString(stored_encoding) << ", not " << sDescriptorEncoding
+        << ": use -f to recompute them.";
+      return EXIT_FAILURE;
+    }
+    // 续算沿用已保存的区域顺序（排序标记）：显式指定了不同的-s时报错，避免同一目录中混杂两种顺序
+    const bool bStoredSorted = !SortedRegionsOrder(sOutDir).empty();
+    if (cmd.used('s') && bStoredSorted != bSortRegions)
+    {
+      OPENMVG_LOG_ERROR << "The regions of " << sOutDir << " are "
+        << (bStoredSorted ? "sorted" : "not sorted") << " by score: use -f to recompute them.";
+      return EXIT_FAILURE;
+    }
+    bSortRegions = bStoredSorted;
   }
   else
   {
@@ -244,20 +391,22 @@ int main(int argc, char **argv)
     else
     if (sImage_Describer_Method == "SIFT_ANATOMY")
     {
+      // 尺度空间的高斯模糊按CPU走SIMD路径（OPENMVG_SIMD=scalar可强制标量路径）
       image_describer.reset(
-        new SIFT_Anatomy_Image_describer(SIFT_Anatomy_Image_describer::Params()));
+        new SIFT_Anatomy_SIMD_Image_describer(SIFT_Anatomy_Image_describer::Params()));
     }
     else
     if (sImage_Describer_Method == "AKAZE_FLOAT")
     {
-      image_describer = AKAZE_Image_describer::create
-        (AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MSURF), !bUpRight);
+      // 非线性尺度空间、对比度因子和检测按固定行块并行（结果与线程数无关）
+      image_describer.reset(new AKAZE_RowBlock_Image_describer
+        (AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MSURF), !bUpRight));
     }
     else
     if (sImage_Describer_Method == "AKAZE_MLDB")
     {
-      image_describer = AKAZE_Image_describer::create
-        (AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MLDB), !bUpRight);
+      image_describer.reset(new AKAZE_RowBlock_Image_describer
+        (AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MLDB), !bUpRight));
     }
     
     //检查图像描述器是否创建成功
@@ -279,6 +428,45 @@ int main(int argc, char **argv)
       }
     }
 
+    // 紧凑描述子：包装SIFT描述器，编码后的区域仍是标准区域类型，匹配和几何过滤直接读取
+    if (descriptor_encoding != EDescriptorEncoding::RAW)
+    {
+      if (!Compact_Image_describer::IsEncodable(*image_describer))
+      {
+        OPENMVG_LOG_ERROR << "The descriptor encoding " << sDescriptorEncoding
+          << " applies to SIFT and SIFT_ANATOMY only.";
+        return EXIT_FAILURE;
+      }
+      std::unique_ptr<Compact_Image_describer> compact_describer(
+        new Compact_Image_describer(std::move(image_describer), descriptor_encoding));
+      // PCA64：在均匀抽取的最多16幅图像上学习投影，随描述器一起保存
+      if (compact_describer->NeedsTraining())
+      {
+        const int kPCATrainingImages = 16;
+        std::vector<const View *> views;
+        for (const auto & view_it : sfm_data.GetViews())
+          views.push_back(view_it.second.get());
+        const std::size_t step = std::max<std::size_t>(1, views.size() / kPCATrainingImages);
+        std::vector<std::unique_ptr<Regions>> samples;
+        std::vector<const Regions *> sample_ptrs;
+        for (std::size_t i = 0; i < views.size(); i += step)
+        {
+          Image<unsigned char> imageGray;
+          if (!ReadImage(stlplus::create_filespec(sfm_data.s_root_path, views[i]->s_Img_path).c_str(), &imageGray))
+            continue;
+          samples.push_back(compact_describer->DescribeRaw(imageGray));
+          if (samples.back())
+            sample_ptrs.push_back(samples.back().get());
+        }
+        if (!compact_describer->TrainPCA(sample_ptrs))
+        {
+          OPENMVG_LOG_ERROR << "Cannot learn the PCA64 projection (not enough descriptors).";
+          return EXIT_FAILURE;
+        }
+      }
+      image_describer = std::move(compact_describer);
+    }
+
     // 导出使用过的图像描述器和区域类型：
     // - 动态未来区域计算和/或加载
     {
@@ -291,115 +479,441 @@ int main(int argc, char **argv)
       archive(cereal::make_nvp("image_describer", image_describer));//将图像描述器的状态序列化为JSON格式并存储在文件中
       auto regionsType = image_describer->Allocate();
       archive(cereal::make_nvp("regions_type", regionsType));
+      // 排序标记：区域按得分降序写出时记录得分（SIFT_ANATOMY不分块时为检测响应，否则为尺度），
+      // 抢占式区域提供者只在有此标记时读取前N个区域
+      if (bSortRegions)
+      {
+        const Compact_Image_describer * compact_sorting = dynamic_cast<const Compact_Image_describer *>(image_describer.get());
+        const bool bResponseOrder = iTileSize <= 0 && dynamic_cast<const SIFT_Anatomy_SIMD_Image_describer *>(
+          compact_sorting ? &compact_sorting->Inner() : image_describer.get());
+        std::string sRegionsOrder = bResponseOrder ? "response" : "scale";
+        archive(cereal::make_nvp(kSortedRegionsEntry, sRegionsOrder));
+      }
     }
   }
 
-  // 特征提取例程
+  // 特征提取例程：三级流水线 解码 -> 描述 -> 保存
+  // 各阶段由专门的工作线程执行，通过有界队列连接：磁盘读写与特征计算重叠，
+  // 总耗时趋近max(I/O, 计算)而不是两者之和；队列长度限制了在途图像占用的内存。
   // 对于SfM_Data容器的每个视图：
-  // - 如果区域文件继续存在，
+  // - 如果区域文件已经存在，跳过
   // - 如果没有文件，则计算特征
   {
-    
     system::Timer timer;//系统计时器初始化
-    Image<unsigned char> imageGray;//灰度图像初始化
+    const system::PageFaultCounters page_faults_start = system::GetPageFaults();
     // 进度条初始化
     system::LoggerProgress my_progress_bar(sfm_data.GetViews().size(), "- EXTRACT FEATURES -" );
 
     //使用布尔值跟踪是否必须停止特征提取
     std::atomic<bool> preemptive_exit(false);
-    
-    // 特征提取循环
+
+    // 预先构建的视图表（按像素数从大到小）：每次迭代O(1)取视图，
+    // 不再在std::map上std::advance（总开销为平方级）
+    const std::vector<const View *> view_table = BuildViewSchedule(sfm_data);
+
+    // 线程预算：未指定-n时按核心数和可用内存（以最大图像的峰值内存估计）确定并行描述的图像数，
+    // 剩余核心留给描述器内部的嵌套并行区域
+    const Compact_Image_describer * compact_describer = dynamic_cast<const Compact_Image_describer *>(image_describer.get());
+    const double describer_bytes_per_pixel = DescriberBytesPerPixel(compact_describer ? compact_describer->Inner() : *image_describer,
+      sFeaturePreset.empty() ? NORMAL_PRESET : stringToEnum(sFeaturePreset));
+    // 分块描述时，尺度空间只与图块（含边界）大小和同时描述的图块数有关
+    const int iTileBorder = iTileSize / 4;
+    auto estimate_view_memory = [&](std::uint64_t width, std::uint64_t height, unsigned int concurrent_tiles)
+    {
+      if (iTileSize <= 0 || (width <= static_cast<std::uint64_t>(iTileSize) && height <= static_cast<std::uint64_t>(iTileSize)))
+        return EstimateDescribeMemory(width, height, describer_bytes_per_pixel);
+      const std::uint64_t padded_tile = iTileSize + 2 * iTileBorder;
+      const std::uint64_t tile_count = ((width + iTileSize - 1) / iTileSize) * ((height + iTileSize - 1) / iTileSize);
+      return 2 * width * height + std::min<std::uint64_t>(tile_count, concurrent_tiles)
+        * EstimateDescribeMemory(std::min(width, padded_tile), std::min(height, padded_tile), describer_bytes_per_pixel);
+    };
+    const std::uint64_t peak_image_memory = view_table.empty() ? 0 :
+      estimate_view_memory(view_table.front()->ui_width, view_table.front()->ui_height, 1);
+    const std::uint64_t available_memory = system::GetAvailableMemory();
+    const ThreadBudget thread_budget = ComputeThreadBudget(
+      iNumThreads > 0 ? iNumThreads : 0, view_table.size(), peak_image_memory,
+      available_memory, system::GetCoreCount());
+
+    // 内存准入控制：每幅图像在解码前按其尺寸、描述器和预设预留峰值内存，描述完成后释放，
+    // 只有预留能放进预算时图像才开始处理（线程数不再是唯一的控制手段，混合分辨率数据也不会OOM）
+    const std::uint64_t memory_budget = iMemoryBudget > 0 ? static_cast<std::uint64_t>(iMemoryBudget) << 20
+      : (available_memory > 0 ? available_memory / 10 * 8 : std::numeric_limits<std::uint64_t>::max());
+    MemoryAdmission memory_admission(memory_budget);
 #ifdef OPENMVG_USE_OPENMP
-    const unsigned int nb_max_thread = omp_get_max_threads();//获取系统可用的最大线程数
+    if (thread_budget.describer_threads > 1)
+      omp_set_max_active_levels(2);
+#endif
 
-    //考虑用户指定线程数的问题
-    if (iNumThreads > 0) {
-        omp_set_num_threads(iNumThreads);
-    } else {
-        omp_set_num_threads(nb_max_thread);
+    // 区域容器：已有容器中同一区域类型的视图视为已计算（其他编码的记录会被重新计算并追加）；
+    // 强制重新计算时从空容器开始
+    const std::string sRegionsPack = RegionsPackFilename(sOutDir);
+    const std::string sRegionsType = RegionsTypeName(*image_describer->Allocate());
+    RegionsPack existing_pack;
+    RegionsPackWriter pack_writer;
+    if (bPackRegions)
+    {
+      if (bForce)
+      {
+        stlplus::file_delete(sRegionsPack);
+        stlplus::file_delete(sRegionsPack + ".index");
+      }
+      else if (stlplus::file_exists(sRegionsPack))
+      {
+        existing_pack.Open(sRegionsPack);
+      }
+      if (!pack_writer.Open(sRegionsPack))
+      {
+        OPENMVG_LOG_ERROR << "Cannot open the regions container: " << sRegionsPack;
+        return EXIT_FAILURE;
+      }
+    }
+    // .feat数量头：.feat是库直接读取的纯特征列表（不能加头部），排序写出的每对.feat/.desc的区域数
+    // 追加到regions_counts.txt，抢占式读取按它核对.desc头部
+    const std::string sRegionsCounts = RegionsCountsFilename(sOutDir);
+    const bool bWriteCounts = bSortRegions && !bPackRegions;
+    RegionsCountsWriter counts_writer;
+    if (bForce)
+      stlplus::file_delete(sRegionsCounts);
+    if (bWriteCounts && !counts_writer.Open(sRegionsCounts))
+    {
+      OPENMVG_LOG_ERROR << "Cannot open the regions count file: " << sRegionsCounts;
+      return EXIT_FAILURE;
     }
 
-    //告知编译器接下来的for循环应该并行执行，并使用动态调度策略
-    #pragma omp parallel for schedule(dynamic) if (iNumThreads > 0) private(imageGray)
-#endif
-    //循环遍历sfm_data.views中的每个视图
-    for (int i = 0; i < static_cast<int>(sfm_data.views.size()); ++i)
+    // 解码比描述快得多：每4个描述线程配1个解码线程；保存阶段只需1个线程
+    PipelineStage decode_stage("decode", std::max(1u, (thread_budget.image_threads + 3) / 4));
+    PipelineStage describe_stage("describe", thread_budget.image_threads);
+    PipelineStage save_stage("save", 1);
+    system::BoundedQueue<std::unique_ptr<DecodedView>> decoded_queue(thread_budget.image_threads);
+    system::BoundedQueue<std::unique_ptr<DescribedView>> described_queue(thread_budget.image_threads);
+
+    // 图像缓冲池：在途图像数（各阶段线程数 + 队列长度）个缓冲在图像之间复用，
+    // 尺寸相同的数据集不再为每幅图像重新分配和首次触碰（缺页）灰度图像
+    ImageBufferPool<unsigned char> image_pool(bBufferPool
+      ? decode_stage.workers + describe_stage.workers + thread_budget.image_threads : 0);
+
+    OPENMVG_LOG_INFO << "Feature extraction pipeline: "
+      << decode_stage.workers << " decode, "
+      << describe_stage.workers << " describe (x " << thread_budget.describer_threads << " describer thread(s)), "
+      << save_stage.workers << " save thread(s)";
+
+    // 全局mask（mask.png）只解码一次，以只读方式被所有视图共享；
+    // 被完全遮挡的图块（kMaskTileSize x kMaskTileSize）在构建尺度空间之前就被裁掉
+    const int kMaskTileSize = 64;
+    std::shared_ptr<const Image<unsigned char>> global_mask;
+    ImageRect global_mask_crop;
+    {
+      const std::string mask_filename_global = stlplus::create_filespec(sfm_data.s_root_path, "mask", "png");
+      if (stlplus::file_exists(mask_filename_global))
+      {
+        std::shared_ptr<Image<unsigned char>> mask = std::make_shared<Image<unsigned char>>();
+        if (!ReadImage(mask_filename_global.c_str(), mask.get()))
+        {
+          OPENMVG_LOG_ERROR
+            << "Invalid mask: " << mask_filename_global << ';'
+            << "Stopping feature extraction.";
+          return EXIT_FAILURE;
+        }
+        global_mask_crop = ComputeMaskedCrop(*mask, kMaskTileSize, kMaskTileSize);
+        global_mask = mask;
+      }
+    }
+    // 只有关键点为SIOPointFeature的区域才能从裁剪图像的坐标移回原图坐标
+    const bool bCropMaskedTiles = OffsetRegions(image_describer->Allocate().get(), 0.f, 0.f);
+    // SIFT_ANATOMY在描述之前按检测响应选择和排序关键点（只算保留关键点的方向和描述子）；
+    // 分块描述时各图块独立检测，仍在合并之后按尺度选择和排序
+    Compact_Image_describer * compact_selecting = dynamic_cast<Compact_Image_describer *>(image_describer.get());
+    SIFT_Anatomy_SIMD_Image_describer * selecting_describer = dynamic_cast<SIFT_Anatomy_SIMD_Image_describer *>(
+      compact_selecting ? &compact_selecting->Inner() : image_describer.get());
+    const bool bSelectInDescriber = selecting_describer && iTileSize <= 0;
+    if (bSelectInDescriber)
+      selecting_describer->SetKeypointSelection(static_cast<std::size_t>(std::max(0, iMaxFeatures)), bSortRegions);
+    std::atomic<long long> described_pixels(0), skipped_pixels(0);
+    std::atomic<long long> detected_keypoints(0), kept_keypoints(0);
+
+    // 阶段1：解码。按调度顺序取视图，读取图像（优先金字塔缓存）和mask
+    std::atomic<int> next_view(0);
+    std::atomic<unsigned int> running_decoders(decode_stage.workers);
+    auto decode_worker = [&]()
     {
-      Views::const_iterator iterViews = sfm_data.views.begin();//声明常量迭代器，并初始化为sfm_data.views开始的位置
-      std::advance(iterViews, i);//访问sfm_data.views中的第i个视图
-      const View * view = iterViews->second.get();//获取第i个视图对应的View对象的指针
-      const std::string
-        sView_filename = stlplus::create_filespec(sfm_data.s_root_path, view->s_Img_path),
-        sFeat = stlplus::create_filespec(sOutDir, stlplus::basename_part(sView_filename), "feat"),//创建特征文件sFeat
-        sDesc = stlplus::create_filespec(sOutDir, stlplus::basename_part(sView_filename), "desc");//创建描述符文件sDesc
-
-      // 对于每个视图，如果特征或描述符文件不存在，则计算它们
-      if (!preemptive_exit && (bForce || !stlplus::file_exists(sFeat) || !stlplus::file_exists(sDesc)))
+      for (int i = next_view++; i < static_cast<int>(view_table.size()) && !preemptive_exit; i = next_view++)
       {
-        if (!ReadImage(sView_filename.c_str(), &imageGray))//使用ReadImage函数读取图像，并将其存储在imageGray中
+        const View * view = view_table[i];//O(1)获取第i个调度的视图
+        std::unique_ptr<DecodedView> decoded(new DecodedView);
+        decoded->sView_filename = stlplus::create_filespec(sfm_data.s_root_path, view->s_Img_path);
+        decoded->sFeat = stlplus::create_filespec(sOutDir, stlplus::basename_part(decoded->sView_filename), "feat");//创建特征文件sFeat
+        decoded->sDesc = stlplus::create_filespec(sOutDir, stlplus::basename_part(decoded->sView_filename), "desc");//创建描述符文件sDesc
+
+        // 特征和描述符文件（或容器中的记录）都已存在时不需要重新计算
+        if (!bForce && (bPackRegions ? existing_pack.Contains(RegionsPackKey(*view), sRegionsType)
+              : stlplus::file_exists(decoded->sFeat) && stlplus::file_exists(decoded->sDesc)))
+        {
+          ++my_progress_bar;
           continue;
+        }
 
-        //
-        // 查看是否有遮挡特征mask
-        //
-        Image<unsigned char> * mask = nullptr; //mask默认为null值
-
-        const std::string
-          mask_filename_local =
-            stlplus::create_filespec(sfm_data.s_root_path,
-              stlplus::basename_part(sView_filename) + "_mask", "png"),
-          mask_filename_global =
-            stlplus::create_filespec(sfm_data.s_root_path, "mask", "png");
+        // 尺寸未知的视图按最大图像估计
+        decoded->reserved_memory = (view->ui_width > 0 && view->ui_height > 0)
+          ? estimate_view_memory(view->ui_width, view->ui_height, thread_budget.describer_threads)
+          : peak_image_memory;
+        memory_admission.Acquire(decoded->reserved_memory);
 
-        Image<unsigned char> imageMask;
-        // 尝试读取本地mask（与当前视图关联的mask）
-        if (stlplus::file_exists(mask_filename_local))
+        bool bDecoded = false;
+        decode_stage.Run([&]()
         {
-          if (!ReadImage(mask_filename_local.c_str(), &imageMask))
+          const std::string & sView_filename = decoded->sView_filename;
+          Image<unsigned char> & imageGray = decoded->imageGray;
+          // 优先从灰度金字塔缓存读取第0层（全分辨率）像素，避免再次解码；
+          // 缓存缺失或过期时由缓冲池解码：文件直接解码到池中的解码缓冲，再转换到池中的灰度图像
+          ImagePyramidCache pyramid_cache;
+          bool bCached = !sPyramidCacheDir.empty()
+            && pyramid_cache.Open(ImagePyramidCache::Filename(sPyramidCacheDir, view->s_Img_path),
+                                  stlplus::file_size(sView_filename), stlplus::file_modified(sView_filename));
+          if (bCached)
           {
-            OPENMVG_LOG_ERROR
-              << "Invalid mask: " << mask_filename_local << ';'
-              << "Stopping feature extraction.";
-            preemptive_exit = true;
-            continue;
+            if (view->ui_width > 0 && view->ui_height > 0)
+              imageGray = image_pool.Acquire(view->ui_width, view->ui_height);
+            bCached = pyramid_cache.ReadLevel(0, imageGray);
           }
-          // 仅当本地mask适合当前图像大小时才使用它
-          if (imageMask.Width() == imageGray.Width() && imageMask.Height() == imageGray.Height())
-            mask = &imageMask;
-        }
-        else//如果本地mask不存在
-        {
-          // 尝试读取全局mask
-          if (stlplus::file_exists(mask_filename_global))
+          if (!bCached && !image_pool.Decode(sView_filename, imageGray))
+            return;
+
+          //
+          // 查看是否有遮挡特征mask：优先使用本地mask（与当前视图关联的mask），否则使用共享的全局mask
+          //
+          const std::string mask_filename_local =
+            stlplus::create_filespec(sfm_data.s_root_path,
+              stlplus::basename_part(sView_filename) + "_mask", "png");
+          std::shared_ptr<const Image<unsigned char>> mask = global_mask;
+          if (stlplus::file_exists(mask_filename_local))
           {
-            if (!ReadImage(mask_filename_global.c_str(), &imageMask))
+            std::shared_ptr<Image<unsigned char>> local_mask = std::make_shared<Image<unsigned char>>();
+            if (!ReadImage(mask_filename_local.c_str(), local_mask.get()))
             {
               OPENMVG_LOG_ERROR
-                << "Invalid mask: " << mask_filename_global << ';'
+                << "Invalid mask: " << mask_filename_local << ';'
                 << "Stopping feature extraction.";
               preemptive_exit = true;
-              continue;
+              return;
             }
-            // 仅当全局mask适合当前图像大小时才使用它
-            if (imageMask.Width() == imageGray.Width() && imageMask.Height() == imageGray.Height())
-              mask = &imageMask;
+            mask = local_mask;
           }
+          // 仅当mask适合当前图像大小时才使用它
+          if (mask && mask->Width() == imageGray.Width() && mask->Height() == imageGray.Height())
+            decoded->mask = mask;
+          bDecoded = true;
+        });
+        if (bDecoded)
+          decoded_queue.Push(std::move(decoded));
+        else
+        {
+          image_pool.Release(std::move(decoded->imageGray));
+          memory_admission.Release(decoded->reserved_memory);
         }
-
-        //计算特征和描述符并将其导出到文件
-        auto regions = image_describer->Describe(imageGray, mask);//特征描述
-        //检查有效特征值是否被提取并保存到sFeat和sDesc文件中
-        if (regions && !image_describer->Save(regions.get(), sFeat, sDesc)) {
-          OPENMVG_LOG_ERROR
-            << "Cannot save regions for image: " << sView_filename << ';'
-            << "Stopping feature extraction.";
-          preemptive_exit = true;
+      }
+      // 最后一个解码线程结束时关闭队列，描述线程在取空队列后退出
+      if (--running_decoders == 0)
+        decoded_queue.Close();
+    };
+
+    // 阶段2：描述。计算特征和描述符
+    std::atomic<unsigned int> running_describers(describe_stage.workers);
+    auto describe_worker = [&]()
+    {
+#ifdef OPENMVG_USE_OPENMP
+      omp_set_num_threads(thread_budget.describer_threads);//本线程内（描述器的嵌套并行区域）使用的线程数
+#endif
+      // 本线程的裁剪缓冲，在图像之间复用
+      Image<unsigned char> crop_gray, crop_mask;
+      std::unique_ptr<DecodedView> decoded;
+      while (decoded_queue.Pop(decoded))
+      {
+        const std::uint64_t reserved_memory = decoded->reserved_memory;
+        if (preemptive_exit)
+        {
+          image_pool.Release(std::move(decoded->imageGray));
+          memory_admission.Release(reserved_memory);
           continue;
         }
+        std::unique_ptr<DescribedView> described(new DescribedView);
+        describe_stage.Run([&]()
+        {
+          const Image<unsigned char> & imageGray = decoded->imageGray;
+          const Image<unsigned char> * mask = decoded->mask.get();
+          const long long image_pixels = static_cast<long long>(imageGray.Width()) * imageGray.Height();
+          ImageRect crop;
+          crop.width = imageGray.Width();
+          crop.height = imageGray.Height();
+          if (mask && bCropMaskedTiles)
+          {
+            crop = (decoded->mask == global_mask) ? global_mask_crop
+              : ComputeMaskedCrop(*mask, kMaskTileSize, kMaskTileSize);
+          }
+          skipped_pixels += image_pixels - crop.area();
+          described_pixels += crop.area();
+          if (crop.empty())
+          {
+            // 整幅图像都被遮挡：不计算尺度空间，保存空的区域
+            described->regions = image_describer->Allocate();
+          }
+          else
+          {
+            // 只描述包含未遮挡图块的部分，再把关键点移回原图坐标
+            const bool bCropped = crop.area() != image_pixels;
+            if (bCropped)
+            {
+              CropImage(imageGray, crop, crop_gray);
+              CropImage(*mask, crop, crop_mask);
+            }
+            const Image<unsigned char> & describe_image = bCropped ? crop_gray : imageGray;
+            const Image<unsigned char> * describe_mask = bCropped ? &crop_mask : mask;
+            // 大于图块的图像分块并行描述，峰值内存取决于图块大小而不是图像大小
+            if (iTileSize > 0 && (describe_image.Width() > iTileSize || describe_image.Height() > iTileSize))
+            {
+              described->regions = DescribeTiled(*image_describer, describe_image, describe_mask,
+                iTileSize, iTileBorder, thread_budget.describer_threads);
+            }
+            if (!described->regions)
+              described->regions = image_describer->Describe(describe_image, describe_mask);//特征描述
+            if (bCropped && described->regions)
+              OffsetRegions(described->regions.get(), static_cast<float>(crop.x), static_cast<float>(crop.y));
+          }
+          // 关键点数上限：按网格均匀保留，匹配代价（与两幅图像特征数之积成正比）可预测
+          if (iMaxFeatures > 0 && described->regions && bSelectInDescriber)
+          {
+            kept_keypoints += described->regions->RegionCount();
+          }
+          else if (iMaxFeatures > 0 && described->regions)
+          {
+            detected_keypoints += described->regions->RegionCount();
+            std::unique_ptr<Regions> selected = SelectUniformRegions(*described->regions,
+              static_cast<std::size_t>(iMaxFeatures), imageGray.Width(), imageGray.Height());
+            if (selected)
+              described->regions = std::move(selected);
+            kept_keypoints += described->regions->RegionCount();
+          }
+          // 按得分降序排列：区域文件（数量由.desc头部、regions_counts.txt或容器记录头部给出）的前N条即最好的N个区域
+          if (bSortRegions && described->regions && !bSelectInDescriber)
+          {
+            std::unique_ptr<Regions> sorted = SortRegionsByScore(*described->regions);
+            if (sorted)
+              described->regions = std::move(sorted);
+          }
+        });
+        described->sView_filename = std::move(decoded->sView_filename);
+        described->sFeat = std::move(decoded->sFeat);
+        described->sDesc = std::move(decoded->sDesc);
+        image_pool.Release(std::move(decoded->imageGray));// 灰度图像缓冲交还给缓冲池
+        decoded.reset();
+        memory_admission.Release(reserved_memory);
+        described_queue.Push(std::move(described));
       }
-      ++my_progress_bar;//更新进度条
+      if (--running_describers == 0)
+        described_queue.Close();
+    };
+
+    // 阶段3：保存。将特征和描述符导出到文件
+    auto save_worker = [&]()
+    {
+      std::unique_ptr<DescribedView> described;
+      while (described_queue.Pop(described))
+      {
+        if (preemptive_exit)
+          continue;
+        save_stage.Run([&]()
+        {
+          //检查有效特征值是否被提取并保存到sFeat和sDesc文件中（或追加到区域容器）
+          const bool bSaved = !described->regions || (bPackRegions
+            ? pack_writer.Append(stlplus::basename_part(described->sView_filename), *described->regions)
+            : image_describer->Save(described->regions.get(), described->sFeat, described->sDesc)
+              && (!bWriteCounts || counts_writer.Append(stlplus::basename_part(described->sView_filename),
+                described->regions->RegionCount())));
+          if (!bSaved)
+          {
+            OPENMVG_LOG_ERROR
+              << "Cannot save regions for image: " << described->sView_filename << ';'
+              << "Stopping feature extraction.";
+            preemptive_exit = true;
+          }
+        });
+        ++my_progress_bar;//更新进度条
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < decode_stage.workers; ++i)
+      workers.emplace_back(decode_worker);
+    for (unsigned int i = 0; i < describe_stage.workers; ++i)
+      workers.emplace_back(describe_worker);
+    for (unsigned int i = 0; i < save_stage.workers; ++i)
+      workers.emplace_back(save_worker);
+    for (auto & worker : workers)
+      worker.join();
+
+    // 关闭容器并重写偏移索引
+    if (bPackRegions && !pack_writer.Close())
+    {
+      OPENMVG_LOG_ERROR << "Cannot write the index of the regions container: " << sRegionsPack;
+      return EXIT_FAILURE;
+    }
+
+    const double elapsed = timer.elapsed();
+    const system::PageFaultCounters page_faults_end = system::GetPageFaults();
+    OPENMVG_LOG_INFO << "Task done in (s): " << elapsed;
+
+    // 流水线统计：阶段占用率（忙碌时间 / (总时间 x 线程数)）和队列长度、等待时间
+    std::ostringstream pipeline_report;
+    pipeline_report << "Feature extraction pipeline report:";
+    for (const PipelineStage * stage : {&decode_stage, &describe_stage, &save_stage})
+    {
+      pipeline_report << "\n stage " << stage->name << ": " << stage->workers << " thread(s), occupancy "
+        << (elapsed > 0.0 ? 100.0 * stage->busy_us.load() * 1e-6 / (elapsed * stage->workers) : 0.0) << "%";
+    }
+    const std::pair<const char *, system::BoundedQueueStats> queue_stats[] =
+    {
+      {"decode -> describe", decoded_queue.Stats()},
+      {"describe -> save", described_queue.Stats()}
+    };
+    for (const auto & queue_it : queue_stats)
+    {
+      const system::BoundedQueueStats & stats = queue_it.second;
+      pipeline_report << "\n queue " << queue_it.first << ": " << stats.pushed << " item(s), depth mean "
+        << stats.mean_depth << " max " << stats.max_depth << " / " << stats.capacity
+        << ", producers blocked (s): " << stats.push_wait_s
+        << ", consumers starved (s): " << stats.pop_wait_s;
+    }
+    pipeline_report << "\n memory budget (MiB): ";
+    if (memory_budget == std::numeric_limits<std::uint64_t>::max())
+      pipeline_report << "unlimited";
+    else
+      pipeline_report << (memory_budget >> 20);
+    pipeline_report << ", peak reserved (MiB): " << (memory_admission.PeakUsage() >> 20)
+      << ", delayed image(s): " << memory_admission.WaitingImages()
+      << " (" << memory_admission.WaitSeconds() << " s)";
+    if (described_pixels + skipped_pixels > 0)
+    {
+      pipeline_report << "\n masked tiles skipped: "
+        << 100.0 * skipped_pixels / static_cast<double>(described_pixels + skipped_pixels) << "% of the pixels";
+    }
+    if (iMaxFeatures > 0 && bSelectInDescriber)
+    {
+      pipeline_report << "\n keypoints kept: " << kept_keypoints << " (max " << iMaxFeatures
+        << " per image, selected by detector response before the description)";
+    }
+    else if (iMaxFeatures > 0 && detected_keypoints > 0)
+    {
+      pipeline_report << "\n keypoints kept: " << kept_keypoints << " of " << detected_keypoints
+        << " (max " << iMaxFeatures << " per image)";
     }
-    OPENMVG_LOG_INFO << "Task done in (s): " << timer.elapsed();
+    // 缓冲复用：实际发生的分配次数（用 -b 0 运行得到不复用时的分配次数和缺页数）
+    const ImageBufferPoolStats pool_stats = image_pool.Stats();
+    pipeline_report << "\n image buffers: " << pool_stats.requests << " request(s), "
+      << pool_stats.allocations << " image allocation(s), "
+      << pool_stats.decode_allocations << " decode buffer allocation(s), "
+      << pool_stats.peak_buffers << " pooled buffer(s) at most"
+      << "\n page faults: " << page_faults_end.minor - page_faults_start.minor << " minor, "
+      << page_faults_end.major - page_faults_start.major << " major";
+    OPENMVG_LOG_INFO << pipeline_report.str();
   }
   return EXIT_SUCCESS;
 }
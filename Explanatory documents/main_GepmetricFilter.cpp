@@ -48,6 +48,11 @@
 #include "third_party/cmdLine/cmdLine.h"//第三方命令行解析
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"//第三方简化文件系统
 
+#include "../Products/compact_descriptors.hpp"//紧凑描述子的区域类型（RootSIFT_Regions、PCA64_Regions）
+#include "../Products/regions_pack.hpp"//区域容器（ComputeFeatures -k）的区域提供者
+#include "../Products/sfm_data_indexed_io.hpp"//索引二进制SfM_Data（.ibin）的读取
+#include "../Products/view_id_pairs.hpp"//在实际的视图ID上构建配对
+
 #include <cstdlib>
 #include <iostream>
 #include <locale>
@@ -218,7 +223,7 @@ int main( int argc, char** argv )
   // 读取SfM场景（图像视图和内部数据）
   //---------------------------------------
   SfM_Data sfm_data;//试图加载输入的SFM文件
-  if ( !Load( sfm_data, sSfM_Data_Filename, ESfM_Data( VIEWS | INTRINSICS ) ) )
+  if ( !LoadSfMData( sfm_data, sSfM_Data_Filename, ESfM_Data( VIEWS | INTRINSICS ) ) )//同时支持索引二进制格式（.ibin）
   {
     OPENMVG_LOG_ERROR << "The input SfM_Data file \"" << sSfM_Data_Filename << "\" cannot be read.";
     return EXIT_FAILURE;
@@ -246,7 +251,20 @@ int main( int argc, char** argv )
 
   // 加载相应的视图区域
   std::shared_ptr<Regions_Provider> regions_provider;
-  if ( ui_max_cache_size == 0 )
+  const bool bPackedRegions = stlplus::file_exists( features::RegionsPackFilename( sMatchesDirectory ) );
+  if ( bPackedRegions && ui_max_cache_size > 0 )
+  {
+    // 区域容器按需映射分页，不使用区域缓存
+    OPENMVG_LOG_ERROR << "The regions of " << sMatchesDirectory << " are in a container (ComputeFeatures -k):"
+                      << " it is mapped and paged on demand, the regions cache (-c) does not apply to it.";
+    return EXIT_FAILURE;
+  }
+  if ( bPackedRegions )
+  {
+    // 区域容器（ComputeFeatures -k）：映射一个文件，代替每个视图打开并解析.feat/.desc
+    regions_provider = std::make_shared<Packed_Regions_Provider>();
+  }
+  else if ( ui_max_cache_size == 0 )
   {
     // 默认区域提供程序（加载并将所有区域存储在内存中）
     regions_provider = std::make_shared<Regions_Provider>();
@@ -281,7 +299,7 @@ int main( int argc, char** argv )
     // 加载输入对
     OPENMVG_LOG_INFO << "Loading input pairs ...";
     Pair_Set input_pairs;
-    loadPairs( sfm_data.GetViews().size(), sInputPairsFilename, input_pairs );//调用函数 loadPairs 从指定的文件名中加载对
+    loadPairs( ViewIdBound( SortedViewIds( sfm_data ) ), sInputPairsFilename, input_pairs );//调用函数 loadPairs 从指定的文件名中加载对（N为最大视图ID+1，增量列图后ID可能不连续）
 
     //使用给定的对过滤匹配项
     OPENMVG_LOG_INFO << "Filtering matches with the given pairs.";
@@ -411,14 +429,14 @@ int main( int argc, char** argv )
     }
 
     // -- 导出几何视图图形统计信息
-    graph::getGraphStatistics(sfm_data.GetViews().size(), getPairs(map_GeometricMatches));
+    graph::getGraphStatistics(ViewIdBound(SortedViewIds(sfm_data)), getPairs(map_GeometricMatches));
 
     OPENMVG_LOG_INFO << "Task done in (s): " << timer.elapsed();
 
     //-- 导出相邻矩阵
     OPENMVG_LOG_INFO <<  "\n Export Adjacency Matrix of the pairwise's geometric matches";
 
-    PairWiseMatchingToAdjacencyMatrixSVG( sfm_data.GetViews().size(),
+    PairWiseMatchingToAdjacencyMatrixSVG( ViewIdBound(SortedViewIds(sfm_data)),
                                           map_GeometricMatches,
                                           stlplus::create_filespec( sMatchesDirectory, "GeometricAdjacencyMatrix", "svg" ) );
 
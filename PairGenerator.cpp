@@ -1,160 +1,303 @@
-// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
-
-// Copyright (c) 2019 Romuald PERROT
-
-// This Source Code Form is subject to the terms of the Mozilla Public
-// License, v. 2.0. If a copy of the MPL was not distributed with this
-// file, You can obtain one at http://mozilla.org/MPL/2.0/.
-
-#include "openMVG/matching_image_collection/Pair_Builder.hpp"
-#include "openMVG/sfm/sfm_data.hpp"
-#include "openMVG/sfm/sfm_data_io.hpp"
-
-#include "third_party/cmdLine/cmdLine.h"
-#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
-
-#include <iostream>
-
-/**
- * @brief 当前可用的配对模式列表
- *
- */
-enum EPairMode
-{
-  PAIR_EXHAUSTIVE = 0, // 构建所有可能的图像配对
-  PAIR_CONTIGUOUS = 1  // 仅连续图像配对（对于video mode很有用）
-};
-
-using namespace openMVG;
-using namespace openMVG::sfm;
-
-void usage( const char* argv0 )
-{
-  std::cerr << "用法: " << argv0 << '\n'
-            << "[-i|--input_file]         SfM_Data 文件\n"//指定输入的SfM_Data文件，包含了场景的结构和图像信息。
-            << "[-o|--output_file]        存储配对的输出文件\n"//指定存储配对输出的文件路径。
-            << "\n[可选]\n"
-            << "[-m|--pair_mode] mode     配对生成模式\n"
-            << "       EXHAUSTIVE:        构建所有可能的配对。[默认]\n"
-            << "       CONTIGUOUS:        为连续图像构建配对（与 --contiguous_count 参数一起使用）\n"
-            << "[-c|--contiguous_count] X 连续链接的数量\n"
-            << "       X: 将匹配0与(1->X)、...]\n"
-            << "       2: 将匹配0与(1,2)，1与(2,3)，...\n"
-            << "       3: 将匹配0与(1,2,3)，1与(2,3,4)，...\n"
-            << std::endl;
-}
-
-// 此可执行文件计算要匹配的图像对
-int main( int argc, char** argv )
-{
-  CmdLine cmd;
-
-  std::string sSfMDataFilename;
-  std::string sOutputPairsFilename;
-  std::string sPairMode        = "EXHAUSTIVE";
-  int         iContiguousCount = -1;
-
-  // 必要元素：
-  cmd.add( make_option( 'i', sSfMDataFilename, "input_file" ) );
-  cmd.add( make_option( 'o', sOutputPairsFilename, "output_file" ) );
-  // 可选元素：
-  cmd.add( make_option( 'm', sPairMode, "pair_mode" ) );
-  cmd.add( make_option( 'c', iContiguousCount, "contiguous_count" ) );
-
-  try
-  {
-    if ( argc == 1 )
-      throw std::string( "无效的命令行参数。" );
-    cmd.process( argc, argv );
-  }
-  catch ( const std::string& s )
-  {
-    usage( argv[ 0 ] );
-    std::cerr << "[错误] " << s << std::endl;
-
-    return EXIT_FAILURE;
-  }
-
-  // 0. 解析参数
-  std::cout << " 您调用了:\n"
-            << argv[ 0 ] << "\n"
-            << "--input_file       : " << sSfMDataFilename << "\n"
-            << "--output_file      : " << sOutputPairsFilename << "\n"
-            << "可选参数\n"
-            << "--pair_mode        : " << sPairMode << "\n"
-            << "--contiguous_count : " << iContiguousCount << "\n"
-            << std::endl;
-
-  if ( sSfMDataFilename.empty() )
-  {
-    usage( argv[ 0 ] );
-    std::cerr << "[错误] 未设置输入文件。" << std::endl;
-    exit( EXIT_FAILURE );
-  }
-  if ( sOutputPairsFilename.empty() )
-  {
-    usage( argv[ 0 ] );
-    std::cerr << "[错误] 未设置输出文件。" << std::endl;
-    exit( EXIT_FAILURE );
-  }
-
-  EPairMode pairMode;
-  if ( sPairMode == "EXHAUSTIVE" )
-  {
-    pairMode = PAIR_EXHAUSTIVE;
-  }
-  else if ( sPairMode == "CONTIGUOUS" )
-  {
-    if ( iContiguousCount == -1 )
-    {
-      usage( argv[ 0 ] );
-      std::cerr << "[错误] 选择了连续配对模式，但未设置 contiguous_count。" << std::endl;
-      exit( EXIT_FAILURE );
-    }
-
-    pairMode = PAIR_CONTIGUOUS;
-  }
-
-  // 1. 加载 SfM 数据场景
-  std::cout << "加载场景.";
-  SfM_Data sfm_data;
-  if ( !Load( sfm_data, sSfMDataFilename, ESfM_Data( VIEWS | INTRINSICS ) ) )
-  {
-    std::cerr << std::endl
-              << "无法读取输入的 SfM_Data 文件 \"" << sSfMDataFilename << "\"。" << std::endl;
-    exit( EXIT_FAILURE );
-  }
-  const size_t NImage = sfm_data.GetViews().size();
-
-  // 2. 计算配对
-  std::cout << "计算配对." << std::endl;
-  Pair_Set pairs;
-  switch ( pairMode )
-  {
-    case PAIR_EXHAUSTIVE:
-    {
-      pairs = exhaustivePairs( NImage );
-      break;
-    }
-    case PAIR_CONTIGUOUS:
-    {
-      pairs = contiguousWithOverlap( NImage, iContiguousCount );
-      break;
-    }
-    default:
-    {
-      std::cerr << "未知的配对模式" << std::endl;
-      exit( EXIT_FAILURE );
-    }
-  }
-
-  // 3. 保存配对
-  std::cout << "保存配对." << std::endl;
-  if ( !savePairs( sOutputPairsFilename, pairs ) )
-  {
-    std::cerr << "无法将配对保存到文件: \"" << sOutputPairsFilename << "\"" << std::endl;
-    exit( EXIT_FAILURE );
-  }
-
-  return EXIT_SUCCESS;
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// Copyright (c) 2019 Romuald PERROT
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "openMVG/matching_image_collection/Pair_Builder.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_io.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include "Products/image_directory_enumerator.hpp"
+#include "Products/sfm_data_indexed_io.hpp"
+#include "Products/view_id_pairs.hpp"
+#include "Products/view_position_index.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+/**
+ * @brief 当前可用的配对模式列表
+ *
+ */
+enum EPairMode
+{
+  PAIR_EXHAUSTIVE = 0, // 构建所有可能的图像配对
+  PAIR_CONTIGUOUS = 1, // 仅连续图像配对（对于video mode很有用）
+  PAIR_NEIGHBORS  = 2  // 仅与空间上最近的图像配对（使用列图阶段写出的GPS空间索引）
+};
+
+using namespace openMVG;
+using namespace openMVG::sfm;
+
+void usage( const char* argv0 )
+{
+  std::cerr << "用法: " << argv0 << '\n'
+            << "[-i|--input_file]         SfM_Data 文件\n"//指定输入的SfM_Data文件，包含了场景的结构和图像信息。
+            << "[-o|--output_file]        存储配对的输出文件\n"//指定存储配对输出的文件路径。
+            << "\n[可选]\n"
+            << "[-m|--pair_mode] mode     配对生成模式\n"
+            << "       EXHAUSTIVE:        构建所有可能的配对。[默认]\n"
+            << "       CONTIGUOUS:        为连续图像构建配对（与 --contiguous_count 参数一起使用）\n"
+            << "       NEIGHBORS:         与最近的 X 个图像配对（与 --view_positions 和 --neighbor_count 参数一起使用）\n"
+            << "[-c|--contiguous_count] X 连续链接的数量\n"
+            << "       X: 将匹配0与(1->X)、...]\n"
+            << "       2: 将匹配0与(1,2)，1与(2,3)，...\n"
+            << "       3: 将匹配0与(1,2,3)，1与(2,3,4)，...\n"
+            << "[-g|--view_positions] file SfMInit_ImageListing 输出的 view_positions.bin（GPS空间索引）\n"
+            << "[-k|--neighbor_count] X   每个图像的近邻数量\n"
+            << "[-s|--skip_views] file    不参与配对的视图列表（每行第一个数字为视图ID，\n"
+            << "                          例如 SfMInit_ImageListing -D mark 输出的 near_duplicates.txt）\n"
+            << std::endl;
+}
+
+// 此可执行文件计算要匹配的图像对
+int main( int argc, char** argv )
+{
+  CmdLine cmd;
+
+  std::string sSfMDataFilename;
+  std::string sOutputPairsFilename;
+  std::string sPairMode        = "EXHAUSTIVE";
+  int         iContiguousCount = -1;
+  std::string sSkipViewsFilename;
+  std::string sViewPositionsFilename;
+  int         iNeighborCount = -1;
+
+  // 必要元素：
+  cmd.add( make_option( 'i', sSfMDataFilename, "input_file" ) );
+  cmd.add( make_option( 'o', sOutputPairsFilename, "output_file" ) );
+  // 可选元素：
+  cmd.add( make_option( 'm', sPairMode, "pair_mode" ) );
+  cmd.add( make_option( 'c', iContiguousCount, "contiguous_count" ) );
+  cmd.add( make_option( 's', sSkipViewsFilename, "skip_views" ) );
+  cmd.add( make_option( 'g', sViewPositionsFilename, "view_positions" ) );
+  cmd.add( make_option( 'k', iNeighborCount, "neighbor_count" ) );
+
+  try
+  {
+    if ( argc == 1 )
+      throw std::string( "无效的命令行参数。" );
+    cmd.process( argc, argv );
+  }
+  catch ( const std::string& s )
+  {
+    usage( argv[ 0 ] );
+    std::cerr << "[错误] " << s << std::endl;
+
+    return EXIT_FAILURE;
+  }
+
+  // 0. 解析参数
+  std::cout << " 您调用了:\n"
+            << argv[ 0 ] << "\n"
+            << "--input_file       : " << sSfMDataFilename << "\n"
+            << "--output_file      : " << sOutputPairsFilename << "\n"
+            << "可选参数\n"
+            << "--pair_mode        : " << sPairMode << "\n"
+            << "--contiguous_count : " << iContiguousCount << "\n"
+            << "--skip_views       : " << sSkipViewsFilename << "\n"
+            << "--view_positions   : " << sViewPositionsFilename << "\n"
+            << "--neighbor_count   : " << iNeighborCount << "\n"
+            << std::endl;
+
+  if ( sSfMDataFilename.empty() )
+  {
+    usage( argv[ 0 ] );
+    std::cerr << "[错误] 未设置输入文件。" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+  if ( sOutputPairsFilename.empty() )
+  {
+    usage( argv[ 0 ] );
+    std::cerr << "[错误] 未设置输出文件。" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  EPairMode pairMode;
+  if ( sPairMode == "EXHAUSTIVE" )
+  {
+    pairMode = PAIR_EXHAUSTIVE;
+  }
+  else if ( sPairMode == "CONTIGUOUS" )
+  {
+    if ( iContiguousCount == -1 )
+    {
+      usage( argv[ 0 ] );
+      std::cerr << "[错误] 选择了连续配对模式，但未设置 contiguous_count。" << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+    pairMode = PAIR_CONTIGUOUS;
+  }
+  else if ( sPairMode == "NEIGHBORS" )
+  {
+    if ( iNeighborCount <= 0 || sViewPositionsFilename.empty() )
+    {
+      usage( argv[ 0 ] );
+      std::cerr << "[错误] 选择了近邻配对模式，但未设置 view_positions 或 neighbor_count。" << std::endl;
+      exit( EXIT_FAILURE );
+    }
+
+    pairMode = PAIR_NEIGHBORS;
+  }
+  else
+  {
+    usage( argv[ 0 ] );
+    std::cerr << "[错误] 未知的配对模式: " << sPairMode << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  // 1. 加载 SfM 数据场景
+  std::cout << "加载场景.";
+  // 配对在实际的视图ID上构建：增量列图（-I）保留已有视图的ID，新视图的ID接在
+  // 之前的最大ID之后，删除的图像留下空缺，所以ID不一定是[0, N)，也不一定按图像文件名排序。
+  // 穷举和近邻模式只需要视图ID：索引二进制格式（.ibin）只读取索引，不解析视图；
+  // 连续模式需要按图像文件名（视频帧顺序）排列视图。
+  std::vector<IndexT> view_ids;
+  bool bLoaded = false;
+  if ( pairMode == PAIR_CONTIGUOUS )
+  {
+    SfM_Data sfm_data;
+    bLoaded = LoadSfMData( sfm_data, sSfMDataFilename, ESfM_Data( VIEWS ) );
+    std::vector<std::pair<std::string, IndexT>> named_views;
+    for ( const auto& view_it : sfm_data.GetViews() )
+      named_views.emplace_back( view_it.second->s_Img_path, view_it.first );
+    // 与列图（SfMInit_ImageListing）相同的自然顺序：frame9在frame10之前
+    std::sort( named_views.begin(), named_views.end(),
+               []( const std::pair<std::string, IndexT>& a, const std::pair<std::string, IndexT>& b )
+               {
+                 if ( system::NaturalLess( a.first, b.first ) )
+                   return true;
+                 if ( system::NaturalLess( b.first, a.first ) )
+                   return false;
+                 return a.second < b.second;
+               } );
+    for ( const auto& named_view : named_views )
+      view_ids.push_back( named_view.second );
+  }
+  else
+  {
+    bLoaded = GetSfMDataViewIds( sSfMDataFilename, view_ids );
+  }
+  if ( !bLoaded )
+  {
+    std::cerr << std::endl
+              << "无法读取输入的 SfM_Data 文件 \"" << sSfMDataFilename << "\"。" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+  const size_t NImage = view_ids.size();
+
+  // 1.1 加载需要跳过的视图（例如近重复图像），每行第一个数字为视图ID，'#'开头为注释
+  std::set<IndexT> skipped_views;
+  if ( !sSkipViewsFilename.empty() )
+  {
+    std::ifstream stream( sSkipViewsFilename.c_str() );
+    if ( !stream )
+    {
+      std::cerr << "无法读取跳过视图文件: \"" << sSkipViewsFilename << "\"" << std::endl;
+      exit( EXIT_FAILURE );
+    }
+    std::string line;
+    while ( std::getline( stream, line ) )
+    {
+      std::istringstream line_stream( line );
+      IndexT view_id;
+      if ( !line.empty() && line[ 0 ] != '#' && ( line_stream >> view_id ) )
+        skipped_views.insert( view_id );
+    }
+    std::cout << "跳过 " << skipped_views.size() << " 个视图." << std::endl;
+  }
+
+  // 2. 计算配对
+  std::cout << "计算配对." << std::endl;
+  Pair_Set pairs;
+  if ( pairMode == PAIR_NEIGHBORS )
+  {
+    // 使用列图阶段写出的空间索引，不需要重新读取EXIF
+    ViewPositionIndex view_positions;
+    if ( !view_positions.Load( sViewPositionsFilename ) )
+    {
+      std::cerr << "无法读取视图位置索引: \"" << sViewPositionsFilename << "\"" << std::endl;
+      exit( EXIT_FAILURE );
+    }
+    const std::set<IndexT> scene_views( view_ids.cbegin(), view_ids.cend() );
+    std::vector<std::pair<IndexT, Vec3>> kept_positions;
+    std::set<IndexT> positioned_views;
+    view_positions.ForEach( [&]( IndexT view_id, const Vec3& position )
+    {
+      if ( skipped_views.count( view_id ) == 0 && scene_views.count( view_id ) != 0 )
+      {
+        kept_positions.emplace_back( view_id, position );
+        positioned_views.insert( view_id );
+      }
+    } );
+    ViewPositionIndex kept_index;
+    kept_index.Build( kept_positions );
+    for ( const auto& kept_position : kept_positions )
+    {
+      for ( const IndexT neighbor_id : kept_index.Nearest( kept_position.second, iNeighborCount, kept_position.first ) )
+      {
+        pairs.insert( { std::min( kept_position.first, neighbor_id ), std::max( kept_position.first, neighbor_id ) } );
+      }
+    }
+    std::cout << "带有GPS位置的视图: " << kept_positions.size() << " / " << NImage << std::endl;
+
+    // 没有GPS位置的视图不能按距离配对：与所有其他保留的视图穷举配对，避免被静默丢弃
+    std::vector<IndexT> unpositioned_views;
+    for ( const IndexT view_id : view_ids )
+    {
+      if ( skipped_views.count( view_id ) == 0 && positioned_views.count( view_id ) == 0 )
+        unpositioned_views.push_back( view_id );
+    }
+    if ( !unpositioned_views.empty() )
+    {
+      std::cerr << "[警告] " << unpositioned_views.size() << " 个视图没有GPS位置，"
+                << "与所有其他视图穷举配对（视图ID: ";
+      for ( size_t i = 0; i < unpositioned_views.size() && i < 10; ++i )
+        std::cerr << ( i ? ", " : "" ) << unpositioned_views[ i ];
+      std::cerr << ( unpositioned_views.size() > 10 ? ", ...)" : ")" ) << std::endl;
+      for ( const IndexT view_id : unpositioned_views )
+      {
+        for ( const IndexT other_id : view_ids )
+        {
+          if ( other_id != view_id && skipped_views.count( other_id ) == 0 )
+            pairs.insert( { std::min( view_id, other_id ), std::max( view_id, other_id ) } );
+        }
+      }
+    }
+  }
+  else
+  {
+    // 在剩余视图上构建配对：连续模式下，跳过的视图不占用连续链接的名额
+    std::vector<IndexT> kept_views;
+    for ( const IndexT view_id : view_ids )
+    {
+      if ( skipped_views.count( view_id ) == 0 )
+        kept_views.push_back( view_id );
+    }
+    if ( pairMode == PAIR_CONTIGUOUS )
+      pairs = ContiguousViewPairs( kept_views, static_cast<size_t>( iContiguousCount ) );
+    else
+      pairs = ExhaustiveViewPairs( kept_views );
+  }
+
+  // 3. 保存配对
+  std::cout << "保存配对." << std::endl;
+  if ( !savePairs( sOutputPairsFilename, pairs ) )
+  {
+    std::cerr << "无法将配对保存到文件: \"" << sOutputPairsFilename << "\"" << std::endl;
+    exit( EXIT_FAILURE );
+  }
+
+  return EXIT_SUCCESS;
 }
\ No newline at end of file
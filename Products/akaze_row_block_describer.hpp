@@ -0,0 +1,196 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_AKAZE_ROW_BLOCK_DESCRIBER_HPP
+#define PRODUCTS_AKAZE_ROW_BLOCK_DESCRIBER_HPP
+
+#include "openMVG/features/akaze/image_describer_akaze_io.hpp"
+#include "openMVG/features/akaze/mldb_descriptor.hpp"
+#include "openMVG/features/akaze/msurf_descriptor.hpp"
+#include "openMVG/image/image_container.hpp"
+
+#include "akaze_row_blocks.hpp"
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/polymorphic.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace openMVG {
+namespace features {
+
+/// AKAZE describer on the row block parallel nonlinear scale space
+/// (akaze_row_blocks.hpp): the scale space, the contrast factor and the
+/// detection run on fixed row blocks, the orientations and the library
+/// MSURF / MLDB descriptors on the keypoints in detection order. The regions
+/// are bit identical whatever the thread count.
+/// Same parameters, presets and regions (AKAZE_Float_Regions,
+/// AKAZE_Binary_Regions) as AKAZE_Image_describer.
+class AKAZE_RowBlock_Image_describer : public AKAZE_Image_describer
+{
+public:
+  explicit AKAZE_RowBlock_Image_describer
+  (
+    const Params & params = Params(),
+    bool bOrientation = true
+  )
+  : AKAZE_Image_describer(params, bOrientation),
+    params_(params),
+    bOrientation_(bOrientation)
+  {}
+
+  bool Set_configuration_preset(EDESCRIBER_PRESET preset) override
+  {
+    switch (preset)
+    {
+    case NORMAL_PRESET:
+      params_.options_.fThreshold = AKAZE::Params().fThreshold;
+    break;
+    case HIGH_PRESET:
+      params_.options_.fThreshold = AKAZE::Params().fThreshold / 10.f;
+    break;
+    case ULTRA_PRESET:
+      params_.options_.fThreshold = AKAZE::Params().fThreshold / 100.f;
+    break;
+    default:
+      return false;
+    }
+    return AKAZE_Image_describer::Set_configuration_preset(preset);
+  }
+
+  /// Threads of the row block loops (0: the OpenMP default of the calling
+  /// thread, i.e. the describer threads set by ComputeFeatures)
+  void SetThreadCount(int thread_count)
+  {
+    thread_count_ = thread_count;
+  }
+
+  std::unique_ptr<Regions> Allocate() const override
+  {
+    if (params_.eAkazeDescriptor_ == AKAZE_MLDB)
+      return std::unique_ptr<Regions>(new AKAZE_Binary_Regions);
+    return std::unique_ptr<Regions>(new AKAZE_Float_Regions);
+  }
+
+  std::unique_ptr<Regions> Describe
+  (
+    const image::Image<unsigned char> & image,
+    const image::Image<unsigned char> * mask = nullptr
+  ) override
+  {
+    int thread_count = thread_count_;
+#ifdef OPENMVG_USE_OPENMP
+    if (thread_count <= 0)
+      thread_count = omp_get_max_threads();
+#endif
+    thread_count = std::max(1, thread_count);
+    const bool bMLDB = params_.eAkazeDescriptor_ == AKAZE_MLDB;
+
+    std::vector<NonlinearEvolution> evolutions;
+    std::vector<NonlinearKeypoint> keypoints;
+    if (image.size() > 0)
+    {
+      // Convert to float in range [0;1]
+      const image::Image<float> If(image.GetMat().cast<float>() / 255.0f);
+      NonlinearScaleSpaceOptions options;
+      options.octave_count = params_.options_.iNbOctave;
+      options.sublevel_count = params_.options_.iNbSlicePerOctave;
+      options.sigma0 = params_.options_.fSigma0;
+      evolutions = BuildNonlinearScaleSpace(If, options, thread_count);
+      // The descriptor pattern (rotated) must lie inside the octave
+      const float border_factor = (bMLDB ? 12.f : 10.f) * std::sqrt(2.f);
+      keypoints = DetectNonlinearKeypoints(evolutions, params_.options_.fThreshold,
+        border_factor, options.derivative_factor, thread_count);
+    }
+    // Feature masking
+    if (mask)
+    {
+      keypoints.erase(std::remove_if(keypoints.begin(), keypoints.end(), [mask](const NonlinearKeypoint & k)
+      {
+        return (*mask)(static_cast<int>(k.y), static_cast<int>(k.x)) == 0;
+      }), keypoints.end());
+    }
+
+    const int keypoint_count = static_cast<int>(keypoints.size());
+    if (bMLDB)
+    {
+      auto regions = std::unique_ptr<AKAZE_Binary_Regions>(new AKAZE_Binary_Regions);
+      regions->Features().resize(keypoint_count);
+      regions->Descriptors().resize(keypoint_count);
+#ifdef OPENMVG_USE_OPENMP
+      #pragma omp parallel for schedule(static) num_threads(thread_count) if (thread_count > 1)
+#endif
+      for (int i = 0; i < keypoint_count; ++i)
+      {
+        const NonlinearEvolution & evolution = evolutions[keypoints[i].level];
+        const SIOPointFeature feature = DescribedFeature(keypoints[i], evolution);
+        Descriptor<bool, 486> bits;
+        ComputeMLDBDescriptor(evolution.Lt, evolution.Lx, evolution.Ly, evolution.octave, feature, bits);
+        // Pack the 486 bits in the 64 bytes of the binary descriptor
+        unsigned char * bytes = reinterpret_cast<unsigned char *>(&regions->Descriptors()[i]);
+        std::memset(bytes, 0, sizeof(AKAZE_Binary_Regions::DescriptorT));
+        for (int bit = 0; bit < 486; ++bit)
+          bytes[bit / 8] |= static_cast<unsigned char>(bits[bit]) << (bit % 8);
+        regions->Features()[i] = feature;
+      }
+      return std::move(regions);
+    }
+
+    auto regions = std::unique_ptr<AKAZE_Float_Regions>(new AKAZE_Float_Regions);
+    regions->Features().resize(keypoint_count);
+    regions->Descriptors().resize(keypoint_count);
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(static) num_threads(thread_count) if (thread_count > 1)
+#endif
+    for (int i = 0; i < keypoint_count; ++i)
+    {
+      const NonlinearEvolution & evolution = evolutions[keypoints[i].level];
+      regions->Features()[i] = DescribedFeature(keypoints[i], evolution);
+      ComputeMSURFDescriptor(evolution.Lx, evolution.Ly, evolution.octave,
+        regions->Features()[i], regions->Descriptors()[i]);
+    }
+    return std::move(regions);
+  }
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(cereal::make_nvp("params", params_),
+       cereal::make_nvp("bOrientation", bOrientation_));
+  }
+
+private:
+  SIOPointFeature DescribedFeature
+  (
+    const NonlinearKeypoint & keypoint,
+    const NonlinearEvolution & evolution
+  ) const
+  {
+    const float angle = bOrientation_ ? ComputeNonlinearOrientation(keypoint, evolution) : 0.f;
+    return SIOPointFeature(keypoint.x, keypoint.y, keypoint.size, angle);
+  }
+
+  // Own copies: the presets of this describer are applied here
+  Params params_;
+  bool bOrientation_;
+  int thread_count_ = 0;
+};
+
+} // namespace features
+} // namespace openMVG
+
+CEREAL_REGISTER_TYPE_WITH_NAME(openMVG::features::AKAZE_RowBlock_Image_describer, "AKAZE_RowBlock_Image_describer");
+CEREAL_REGISTER_POLYMORPHIC_RELATION(openMVG::features::Image_describer, openMVG::features::AKAZE_RowBlock_Image_describer)
+
+#endif // PRODUCTS_AKAZE_ROW_BLOCK_DESCRIBER_HPP
@@ -0,0 +1,674 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_AKAZE_ROW_BLOCKS_HPP
+#define PRODUCTS_AKAZE_ROW_BLOCKS_HPP
+
+#include "openMVG/image/image_container.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace openMVG {
+namespace features {
+
+/// Row block parallel kernels of the AKAZE nonlinear scale space
+/// (Gaussian & Scharr filters, contrast factor, Perona-Malik conductance,
+/// FED diffusion steps and Hessian determinant response).
+///
+/// The rows are split in fixed blocks of kRowBlock rows, independently of
+/// the thread count, and every output pixel is computed by a single thread
+/// with the same arithmetic as the serial loop: the results are identical
+/// whatever the number of threads (thread_count = 1 is the serial path).
+namespace akaze_row_blocks {
+
+static const int kRowBlock = 32;
+
+inline int RowBlockCount(int rows)
+{
+  return (rows + kRowBlock - 1) / kRowBlock;
+}
+
+/// Call functor(row_begin, row_end) on the row blocks of [0, rows)
+template <typename Functor>
+void ForEachRowBlock
+(
+  int rows,
+  int thread_count,
+  Functor functor
+)
+{
+  const int block_count = RowBlockCount(rows);
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(static) num_threads(std::max(1, thread_count)) if (thread_count > 1)
+#endif
+  for (int block = 0; block < block_count; ++block)
+  {
+    functor(block * kRowBlock, std::min(rows, (block + 1) * kRowBlock));
+  }
+}
+
+inline int Clamp(int value, int size)
+{
+  return value < 0 ? 0 : (value >= size ? size - 1 : value);
+}
+
+/// Separable Gaussian blur (border: replicate)
+inline void GaussianBlur
+(
+  const image::Image<float> & in,
+  float sigma,
+  image::Image<float> & out,
+  int thread_count
+)
+{
+  const int radius = std::max(1, static_cast<int>(std::ceil(3.f * sigma)));
+  std::vector<float> kernel(2 * radius + 1);
+  float sum = 0.f;
+  for (int i = -radius; i <= radius; ++i)
+  {
+    kernel[i + radius] = std::exp(-(i * i) / (2.f * sigma * sigma));
+    sum += kernel[i + radius];
+  }
+  for (float & value : kernel)
+    value /= sum;
+
+  const int width = in.Width(), height = in.Height();
+  image::Image<float> horizontal(width, height, false);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    for (int y = row_begin; y < row_end; ++y)
+      for (int x = 0; x < width; ++x)
+      {
+        float value = 0.f;
+        for (int i = -radius; i <= radius; ++i)
+          value += kernel[i + radius] * in(y, Clamp(x + i, width));
+        horizontal(y, x) = value;
+      }
+  });
+  out.resize(width, height, false);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    for (int y = row_begin; y < row_end; ++y)
+      for (int x = 0; x < width; ++x)
+      {
+        float value = 0.f;
+        for (int i = -radius; i <= radius; ++i)
+          value += kernel[i + radius] * horizontal(Clamp(y + i, height), x);
+        out(y, x) = value;
+      }
+  });
+}
+
+/// Normalized Scharr derivative at a given step (AKAZE multiscale
+/// derivatives): [-1 0 1] along the derivative axis and [3 10 3] across it,
+/// the samples being `step` pixels apart (border: replicate).
+inline void ScharrDerivative
+(
+  const image::Image<float> & in,
+  int step,
+  bool x_derivative,
+  image::Image<float> & out,
+  int thread_count
+)
+{
+  const float w = 10.f / 3.f;
+  const float norm = 1.f / (2.f * step * (w + 2.f));
+  const int width = in.Width(), height = in.Height();
+  out.resize(width, height, false);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    for (int y = row_begin; y < row_end; ++y)
+    {
+      const int y_prev = Clamp(y - step, height), y_next = Clamp(y + step, height);
+      for (int x = 0; x < width; ++x)
+      {
+        const int x_prev = Clamp(x - step, width), x_next = Clamp(x + step, width);
+        out(y, x) = x_derivative
+          ? norm * ((in(y_prev, x_next) - in(y_prev, x_prev))
+                  + w * (in(y, x_next) - in(y, x_prev))
+                  + (in(y_next, x_next) - in(y_next, x_prev)))
+          : norm * ((in(y_next, x_prev) - in(y_prev, x_prev))
+                  + w * (in(y_next, x) - in(y_prev, x))
+                  + (in(y_next, x_next) - in(y_prev, x_next)));
+      }
+    }
+  });
+}
+
+/// Contrast factor k: percentile of the gradient magnitude histogram of the
+/// smoothed image. The per block histograms (integer counts) and maxima are
+/// merged exactly, so k does not depend on the thread count.
+inline float ComputeContrastFactor
+(
+  const image::Image<float> & image,
+  float percentile,
+  int bin_count,
+  int thread_count
+)
+{
+  image::Image<float> smoothed, lx, ly;
+  GaussianBlur(image, 1.f, smoothed, thread_count);
+  ScharrDerivative(smoothed, 1, true, lx, thread_count);
+  ScharrDerivative(smoothed, 1, false, ly, thread_count);
+  const int width = image.Width(), height = image.Height();
+
+  // Skip the borders
+  image::Image<float> magnitude(width, height, true, 0.f);
+  const int block_count = RowBlockCount(height);
+  std::vector<float> block_max(block_count, 0.f);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    float local_max = 0.f;
+    for (int y = std::max(1, row_begin); y < std::min(height - 1, row_end); ++y)
+      for (int x = 1; x < width - 1; ++x)
+      {
+        magnitude(y, x) = std::sqrt(lx(y, x) * lx(y, x) + ly(y, x) * ly(y, x));
+        local_max = std::max(local_max, magnitude(y, x));
+      }
+    block_max[row_begin / kRowBlock] = local_max;
+  });
+  const float max_magnitude = *std::max_element(block_max.begin(), block_max.end());
+  if (max_magnitude <= 0.f)
+    return 0.03f; // flat image, AKAZE default
+
+  std::vector<std::vector<std::int64_t>> block_histograms(block_count, std::vector<std::int64_t>(bin_count, 0));
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    std::vector<std::int64_t> & histogram = block_histograms[row_begin / kRowBlock];
+    for (int y = std::max(1, row_begin); y < std::min(height - 1, row_end); ++y)
+      for (int x = 1; x < width - 1; ++x)
+        if (magnitude(y, x) > 0.f)
+        {
+          const int bin = std::min(bin_count - 1, static_cast<int>(bin_count * (magnitude(y, x) / max_magnitude)));
+          ++histogram[bin];
+        }
+  });
+  std::vector<std::int64_t> histogram(bin_count, 0);
+  std::int64_t total = 0;
+  for (const auto & block_histogram : block_histograms)
+    for (int bin = 0; bin < bin_count; ++bin)
+    {
+      histogram[bin] += block_histogram[bin];
+      total += block_histogram[bin];
+    }
+  const std::int64_t threshold = static_cast<std::int64_t>(total * percentile);
+  std::int64_t cumulated = 0;
+  int bin = 0;
+  for (; bin < bin_count && cumulated < threshold; ++bin)
+    cumulated += histogram[bin];
+  return (cumulated < threshold) ? 0.03f : max_magnitude * bin / static_cast<float>(bin_count);
+}
+
+/// Perona-Malik g2 conductance: 1 / (1 + |grad|^2 / k^2)
+inline void ComputeConductance
+(
+  const image::Image<float> & lx,
+  const image::Image<float> & ly,
+  float contrast_factor,
+  image::Image<float> & conductance,
+  int thread_count
+)
+{
+  const int width = lx.Width(), height = lx.Height();
+  const float inv_k2 = 1.f / (contrast_factor * contrast_factor);
+  conductance.resize(width, height, false);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    for (int y = row_begin; y < row_end; ++y)
+      for (int x = 0; x < width; ++x)
+        conductance(y, x) = 1.f / (1.f + (lx(y, x) * lx(y, x) + ly(y, x) * ly(y, x)) * inv_k2);
+  });
+}
+
+/// One explicit FED diffusion step: out = in + tau/2 * div(c grad(in))
+inline void FEDStep
+(
+  const image::Image<float> & in,
+  const image::Image<float> & conductance,
+  float tau,
+  image::Image<float> & out,
+  int thread_count
+)
+{
+  const int width = in.Width(), height = in.Height();
+  const float half_tau = 0.5f * tau;
+  out.resize(width, height, false);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    for (int y = row_begin; y < row_end; ++y)
+    {
+      const int y_prev = Clamp(y - 1, height), y_next = Clamp(y + 1, height);
+      for (int x = 0; x < width; ++x)
+      {
+        const int x_prev = Clamp(x - 1, width), x_next = Clamp(x + 1, width);
+        const float c = conductance(y, x), value = in(y, x);
+        const float flux =
+            (c + conductance(y, x_next)) * (in(y, x_next) - value)
+          - (conductance(y, x_prev) + c) * (value - in(y, x_prev))
+          + (c + conductance(y_next, x)) * (in(y_next, x) - value)
+          - (conductance(y_prev, x) + c) * (value - in(y_prev, x));
+        out(y, x) = value + half_tau * flux;
+      }
+    }
+  });
+}
+
+/// FED step sizes of a cycle reaching the diffusion time T
+/// (Grewenig et al., tau_max = 0.25 for the 2D explicit scheme), in the
+/// kappa cycle order that keeps the intermediate results stable.
+inline std::vector<float> FEDCycleSteps(float T, float tau_max = 0.25f)
+{
+  const int n = static_cast<int>(std::ceil(std::sqrt(3.f * T / tau_max + 0.25f) - 0.5f - 1e-8f) + 0.5f);
+  if (n <= 0)
+    return {};
+  const float scale = 3.f * T / (tau_max * (n * n + n));
+  std::vector<float> sorted_steps(n);
+  for (int i = 0; i < n; ++i)
+  {
+    const float h = std::cos(static_cast<float>(M_PI) * (2.f * i + 1.f) / (4.f * n + 2.f));
+    sorted_steps[i] = scale * tau_max / (2.f * h * h);
+  }
+  // Kappa cycle: permutation modulo the smallest prime > n, kappa = n / 2
+  const auto is_prime = [](int value)
+  {
+    if (value < 2)
+      return false;
+    for (int divisor = 2; divisor * divisor <= value; ++divisor)
+      if (value % divisor == 0)
+        return false;
+    return true;
+  };
+  int prime = n + 1;
+  while (!is_prime(prime))
+    ++prime;
+  const int kappa = std::max(1, n / 2);
+  std::vector<float> steps(n);
+  for (int k = 0, l = 0; l < n; ++k, ++l)
+  {
+    int index = 0;
+    while ((index = ((k + 1) * kappa) % prime - 1) >= n || index < 0)
+      ++k;
+    steps[l] = sorted_steps[index];
+  }
+  return steps;
+}
+
+/// Half size image (2x2 mean)
+inline void HalfSample
+(
+  const image::Image<float> & in,
+  image::Image<float> & out,
+  int thread_count
+)
+{
+  const int width = std::max(1, in.Width() / 2), height = std::max(1, in.Height() / 2);
+  out.resize(width, height, false);
+  ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+  {
+    for (int y = row_begin; y < row_end; ++y)
+      for (int x = 0; x < width; ++x)
+      {
+        const int x0 = std::min(2 * x, in.Width() - 1), x1 = std::min(2 * x + 1, in.Width() - 1);
+        const int y0 = std::min(2 * y, in.Height() - 1), y1 = std::min(2 * y + 1, in.Height() - 1);
+        out(y, x) = 0.25f * (in(y0, x0) + in(y0, x1) + in(y1, x0) + in(y1, x1));
+      }
+  });
+}
+
+} // namespace akaze_row_blocks
+
+/// One level of the nonlinear scale space
+struct NonlinearEvolution
+{
+  image::Image<float> Lt;      // diffused image
+  image::Image<float> Lx, Ly;  // scale normalized first derivatives
+  image::Image<float> Ldet;    // scale normalized Hessian determinant
+  float esigma = 0.f;          // scale
+  float etime = 0.f;           // diffusion time
+  int octave = 0;
+  int sigma_size = 1;          // derivative step, in pixels of the octave
+};
+
+struct NonlinearScaleSpaceOptions
+{
+  int octave_count = 4;
+  int sublevel_count = 4;
+  float sigma0 = 1.6f;
+  float derivative_factor = 1.5f;
+  float contrast_percentile = 0.7f;
+  int contrast_bin_count = 300;
+};
+
+/// AKAZE nonlinear scale space (FED diffusion of the Perona-Malik g2
+/// equation), its first derivatives and Hessian responses, row block parallel.
+inline std::vector<NonlinearEvolution> BuildNonlinearScaleSpace
+(
+  const image::Image<float> & image,
+  const NonlinearScaleSpaceOptions & options,
+  int thread_count
+)
+{
+  using namespace akaze_row_blocks;
+  std::vector<NonlinearEvolution> evolutions;
+  if (image.Width() < 2 || image.Height() < 2)
+    return evolutions;
+  const int octave_count = std::min(options.octave_count,
+    static_cast<int>(std::log2(std::min(image.Width(), image.Height()))));
+  for (int octave = 0; octave < octave_count; ++octave)
+  {
+    for (int sublevel = 0; sublevel < options.sublevel_count; ++sublevel)
+    {
+      NonlinearEvolution evolution;
+      evolution.esigma = options.sigma0 * std::pow(2.f, sublevel / static_cast<float>(options.sublevel_count) + octave);
+      evolution.etime = 0.5f * evolution.esigma * evolution.esigma;
+      evolution.octave = octave;
+      evolution.sigma_size = std::max(1, static_cast<int>(std::round(
+        evolution.esigma * options.derivative_factor / static_cast<float>(1 << octave))));
+      evolutions.push_back(std::move(evolution));
+    }
+  }
+  if (evolutions.empty())
+    return evolutions;
+
+  float contrast_factor = ComputeContrastFactor(image, options.contrast_percentile,
+                                                options.contrast_bin_count, thread_count);
+  GaussianBlur(image, options.sigma0, evolutions[0].Lt, thread_count);
+
+  image::Image<float> smoothed, lx, ly, conductance, step;
+  for (std::size_t i = 1; i < evolutions.size(); ++i)
+  {
+    image::Image<float> current;
+    if (evolutions[i].octave > evolutions[i - 1].octave)
+    {
+      HalfSample(evolutions[i - 1].Lt, current, thread_count);
+      contrast_factor *= 0.75f;
+    }
+    else
+    {
+      current = evolutions[i - 1].Lt;
+    }
+    GaussianBlur(current, 1.f, smoothed, thread_count);
+    ScharrDerivative(smoothed, 1, true, lx, thread_count);
+    ScharrDerivative(smoothed, 1, false, ly, thread_count);
+    ComputeConductance(lx, ly, contrast_factor, conductance, thread_count);
+
+    for (const float tau : FEDCycleSteps(evolutions[i].etime - evolutions[i - 1].etime))
+    {
+      FEDStep(current, conductance, tau, step, thread_count);
+      std::swap(current, step);
+    }
+    evolutions[i].Lt = std::move(current);
+  }
+
+  // Multiscale derivatives: Scharr filters of step sigma_size on the
+  // smoothed level, normalized by sigma_size per derivation order
+  image::Image<float> lxx, lyy, lxy;
+  for (NonlinearEvolution & evolution : evolutions)
+  {
+    const int sigma_size = evolution.sigma_size;
+    GaussianBlur(evolution.Lt, 1.f, smoothed, thread_count);
+    ScharrDerivative(smoothed, sigma_size, true, evolution.Lx, thread_count);
+    ScharrDerivative(smoothed, sigma_size, false, evolution.Ly, thread_count);
+    ScharrDerivative(evolution.Lx, sigma_size, true, lxx, thread_count);
+    ScharrDerivative(evolution.Ly, sigma_size, false, lyy, thread_count);
+    ScharrDerivative(evolution.Lx, sigma_size, false, lxy, thread_count);
+
+    const float norm = static_cast<float>(sigma_size);
+    const float norm2 = norm * norm;
+    const int width = evolution.Lt.Width();
+    evolution.Ldet.resize(width, evolution.Lt.Height(), false);
+    ForEachRowBlock(evolution.Lt.Height(), thread_count, [&](int row_begin, int row_end)
+    {
+      for (int y = row_begin; y < row_end; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+          evolution.Ldet(y, x) = (norm2 * lxx(y, x)) * (norm2 * lyy(y, x)) - (norm2 * lxy(y, x)) * (norm2 * lxy(y, x));
+          evolution.Lx(y, x) *= norm;
+          evolution.Ly(y, x) *= norm;
+        }
+    });
+  }
+  return evolutions;
+}
+
+/// Keypoint of the nonlinear scale space, in image coordinates
+struct NonlinearKeypoint
+{
+  float x = 0.f, y = 0.f;
+  float size = 0.f;      // esigma * derivative_factor
+  float angle = 0.f;     // radians
+  float response = 0.f;  // Hessian determinant
+  int level = 0;         // evolution index
+};
+
+/// Hessian determinant maxima of the evolutions:
+/// - 3x3 local maxima above threshold whose descriptor window
+///   (border_factor * sigma_size pixels) lies inside the octave,
+/// - non maximum suppression across the neighbouring levels: a keypoint is
+///   dropped if a stronger one of its level or of the levels just below or
+///   above lies within its size (ties: the first in detection order wins),
+/// - sub-pixel refinement by a quadratic fit of the response.
+/// The candidates of each row block are concatenated in block order and each
+/// decision only reads the candidate list, so the keypoints and their order
+/// (level, row, column) do not depend on the thread count.
+inline std::vector<NonlinearKeypoint> DetectNonlinearKeypoints
+(
+  const std::vector<NonlinearEvolution> & evolutions,
+  float threshold,
+  float border_factor,
+  float derivative_factor,
+  int thread_count
+)
+{
+  using namespace akaze_row_blocks;
+  std::vector<NonlinearKeypoint> candidates;
+  for (std::size_t level = 0; level < evolutions.size(); ++level)
+  {
+    const NonlinearEvolution & evolution = evolutions[level];
+    const image::Image<float> & Ldet = evolution.Ldet;
+    const int width = Ldet.Width(), height = Ldet.Height();
+    const int margin = static_cast<int>(std::ceil(border_factor * evolution.sigma_size)) + 1;
+    const float ratio = static_cast<float>(1 << evolution.octave);
+    std::vector<std::vector<NonlinearKeypoint>> block_candidates(RowBlockCount(height));
+    ForEachRowBlock(height, thread_count, [&](int row_begin, int row_end)
+    {
+      std::vector<NonlinearKeypoint> & found = block_candidates[row_begin / kRowBlock];
+      for (int y = std::max(margin, row_begin); y < std::min(height - margin, row_end); ++y)
+        for (int x = margin; x < width - margin; ++x)
+        {
+          const float value = Ldet(y, x);
+          if (value <= threshold
+              || value <= Ldet(y - 1, x - 1) || value <= Ldet(y - 1, x) || value <= Ldet(y - 1, x + 1)
+              || value <= Ldet(y, x - 1) || value <= Ldet(y, x + 1)
+              || value <= Ldet(y + 1, x - 1) || value <= Ldet(y + 1, x) || value <= Ldet(y + 1, x + 1))
+            continue;
+          NonlinearKeypoint keypoint;
+          keypoint.x = x * ratio;
+          keypoint.y = y * ratio;
+          keypoint.size = evolution.esigma * derivative_factor;
+          keypoint.response = value;
+          keypoint.level = static_cast<int>(level);
+          found.push_back(keypoint);
+        }
+    });
+    for (const auto & found : block_candidates)
+      candidates.insert(candidates.end(), found.begin(), found.end());
+  }
+
+  // Per level grid of the candidates (cell: the level keypoint size),
+  // sorted by cell key for the range queries
+  const auto cell_key = [](int cx, int cy)
+  {
+    return (static_cast<std::int64_t>(cy) << 32) | static_cast<std::uint32_t>(cx);
+  };
+  std::vector<std::vector<std::pair<std::int64_t, int>>> grids(evolutions.size());
+  for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
+  {
+    const NonlinearKeypoint & keypoint = candidates[i];
+    grids[keypoint.level].emplace_back(cell_key(
+      static_cast<int>(keypoint.x / keypoint.size), static_cast<int>(keypoint.y / keypoint.size)), i);
+  }
+  for (auto & grid : grids)
+    std::sort(grid.begin(), grid.end());
+
+  const int candidate_count = static_cast<int>(candidates.size());
+  std::vector<NonlinearKeypoint> refined(candidate_count);
+  std::vector<unsigned char> kept(candidate_count, 0);
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(static) num_threads(std::max(1, thread_count)) if (thread_count > 1)
+#endif
+  for (int i = 0; i < candidate_count; ++i)
+  {
+    const NonlinearKeypoint & keypoint = candidates[i];
+    const float radius2 = keypoint.size * keypoint.size;
+    bool bMaximum = true;
+    for (int level = std::max(0, keypoint.level - 1);
+         bMaximum && level <= std::min(static_cast<int>(evolutions.size()) - 1, keypoint.level + 1); ++level)
+    {
+      const auto & grid = grids[level];
+      if (grid.empty())
+        continue;
+      const float cell = evolutions[level].esigma * derivative_factor;
+      const int ring = static_cast<int>(std::ceil(keypoint.size / cell));
+      const int cx = static_cast<int>(keypoint.x / cell), cy = static_cast<int>(keypoint.y / cell);
+      for (int gy = cy - ring; bMaximum && gy <= cy + ring; ++gy)
+        for (int gx = cx - ring; bMaximum && gx <= cx + ring; ++gx)
+        {
+          const auto range = std::equal_range(grid.cbegin(), grid.cend(),
+            std::make_pair(cell_key(gx, gy), 0),
+            [](const std::pair<std::int64_t, int> & a, const std::pair<std::int64_t, int> & b)
+            {
+              return a.first < b.first;
+            });
+          for (auto it = range.first; it != range.second; ++it)
+          {
+            const NonlinearKeypoint & other = candidates[it->second];
+            if (it->second == i)
+              continue;
+            const float dx = other.x - keypoint.x, dy = other.y - keypoint.y;
+            if (dx * dx + dy * dy > radius2)
+              continue;
+            if (other.response > keypoint.response
+                || (other.response == keypoint.response && it->second < i))
+            {
+              bMaximum = false;
+              break;
+            }
+          }
+        }
+    }
+    if (!bMaximum)
+      continue;
+
+    // Sub-pixel refinement: maximum of the quadratic fit of the response
+    const NonlinearEvolution & evolution = evolutions[keypoint.level];
+    const float ratio = static_cast<float>(1 << evolution.octave);
+    const int x = static_cast<int>(keypoint.x / ratio), y = static_cast<int>(keypoint.y / ratio);
+    const image::Image<float> & Ldet = evolution.Ldet;
+    const float Dx = 0.5f * (Ldet(y, x + 1) - Ldet(y, x - 1));
+    const float Dy = 0.5f * (Ldet(y + 1, x) - Ldet(y - 1, x));
+    const float Dxx = Ldet(y, x + 1) + Ldet(y, x - 1) - 2.f * Ldet(y, x);
+    const float Dyy = Ldet(y + 1, x) + Ldet(y - 1, x) - 2.f * Ldet(y, x);
+    const float Dxy = 0.25f * (Ldet(y + 1, x + 1) + Ldet(y - 1, x - 1) - Ldet(y - 1, x + 1) - Ldet(y + 1, x - 1));
+    const float det = Dxx * Dyy - Dxy * Dxy;
+    if (det == 0.f)
+      continue;
+    const float offset_x = -(Dyy * Dx - Dxy * Dy) / det;
+    const float offset_y = -(Dxx * Dy - Dxy * Dx) / det;
+    if (std::abs(offset_x) > 1.f || std::abs(offset_y) > 1.f)
+      continue; // not stable
+    refined[i] = keypoint;
+    refined[i].x = (x + offset_x) * ratio;
+    refined[i].y = (y + offset_y) * ratio;
+    kept[i] = 1;
+  }
+
+  std::vector<NonlinearKeypoint> keypoints;
+  for (int i = 0; i < candidate_count; ++i)
+    if (kept[i])
+      keypoints.push_back(refined[i]);
+  return keypoints;
+}
+
+/// Main orientation of a keypoint (AKAZE): first derivatives sampled every
+/// sigma_size pixels within 6 sigma_size, Gaussian weighted (sigma 2.5
+/// samples), summed in a sliding pi/3 window; the longest sum gives the angle.
+inline float ComputeNonlinearOrientation
+(
+  const NonlinearKeypoint & keypoint,
+  const NonlinearEvolution & evolution
+)
+{
+  using namespace akaze_row_blocks;
+  const float two_pi = 2.f * static_cast<float>(M_PI);
+  const auto angle_of = [two_pi](float x, float y)
+  {
+    const float angle = std::atan2(y, x);
+    return angle < 0.f ? angle + two_pi : angle;
+  };
+  const float ratio = static_cast<float>(1 << evolution.octave);
+  const int s = evolution.sigma_size;
+  const float xf = keypoint.x / ratio, yf = keypoint.y / ratio;
+  const int width = evolution.Lx.Width(), height = evolution.Lx.Height();
+
+  std::vector<float> response_x, response_y, angles;
+  response_x.reserve(109);
+  response_y.reserve(109);
+  angles.reserve(109);
+  for (int i = -6; i <= 6; ++i)
+    for (int j = -6; j <= 6; ++j)
+    {
+      if (i * i + j * j >= 36)
+        continue;
+      const int ix = Clamp(static_cast<int>(std::round(xf + i * s)), width);
+      const int iy = Clamp(static_cast<int>(std::round(yf + j * s)), height);
+      const float weight = std::exp(-(i * i + j * j) / (2.f * 2.5f * 2.5f));
+      response_x.push_back(weight * evolution.Lx(iy, ix));
+      response_y.push_back(weight * evolution.Ly(iy, ix));
+      angles.push_back(angle_of(response_x.back(), response_y.back()));
+    }
+
+  float max_norm2 = 0.f, orientation = 0.f;
+  for (float angle_begin = 0.f; angle_begin < two_pi; angle_begin += 0.15f)
+  {
+    const float angle_end = (angle_begin + static_cast<float>(M_PI) / 3.f > two_pi)
+      ? angle_begin - 5.f * static_cast<float>(M_PI) / 3.f
+      : angle_begin + static_cast<float>(M_PI) / 3.f;
+    float sum_x = 0.f, sum_y = 0.f;
+    for (std::size_t k = 0; k < angles.size(); ++k)
+    {
+      const float angle = angles[k];
+      const bool bInside = (angle_begin < angle_end)
+        ? (angle_begin < angle && angle < angle_end)
+        : ((angle > 0.f && angle < angle_end) || angle > angle_begin);
+      if (bInside)
+      {
+        sum_x += response_x[k];
+        sum_y += response_y[k];
+      }
+    }
+    if (sum_x * sum_x + sum_y * sum_y > max_norm2)
+    {
+      max_norm2 = sum_x * sum_x + sum_y * sum_y;
+      orientation = angle_of(sum_x, sum_y);
+    }
+  }
+  return orientation;
+}
+
+} // namespace features
+} // namespace openMVG
+
+#endif // PRODUCTS_AKAZE_ROW_BLOCKS_HPP
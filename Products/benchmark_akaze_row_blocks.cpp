@@ -0,0 +1,178 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// AKAZE description with the row block parallel describer (the
+// ComputeFeatures AKAZE_FLOAT / AKAZE_MLDB path) on 1 thread versus N
+// threads, for both descriptors. Reports the speedup, the stock
+// AKAZE_Image_describer time for reference, and checks that the regions of
+// 1 and N threads are bit identical (same count, order, keypoints and
+// descriptor bytes).
+//
+//   benchmark_akaze_row_blocks [-i image] [-w width -h height] [-r runs]
+//                              [-n threads]
+
+#include "openMVG/features/akaze/image_describer_akaze.hpp"
+#include "openMVG/image/image_io.hpp"
+#include "openMVG/system/logger.hpp"
+#include "openMVG/system/timer.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+
+#include "akaze_row_block_describer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::image;
+
+// Deterministic textured test image (blobs and corners on a noisy gradient)
+static Image<unsigned char> SyntheticImage(int width, int height)
+{
+  Image<unsigned char> image(width, height);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> noise(0, 12);
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x)
+    {
+      const float blobs = 0.5f + 0.25f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+      const float checker = (((x / 37) + (y / 53)) % 2) ? 0.15f : 0.f;
+      image(y, x) = static_cast<unsigned char>(std::min(255.f, 200.f * (blobs + checker)) + noise(rng) * 0.5f);
+    }
+  return image;
+}
+
+static double MedianTime(int runs, Image_describer & describer, const Image<unsigned char> & image,
+                         std::unique_ptr<Regions> & regions)
+{
+  std::vector<double> timings;
+  for (int run = 0; run < runs; ++run)
+  {
+    system::Timer timer;
+    regions = describer.Describe(image, nullptr);
+    timings.push_back(timer.elapsed());
+  }
+  std::sort(timings.begin(), timings.end());
+  return timings[timings.size() / 2];
+}
+
+/// Same region count and order, same keypoint floats and descriptor bytes
+template <typename RegionsT>
+static bool BitIdentical(const Regions & a, const Regions & b)
+{
+  const RegionsT * regions_a = dynamic_cast<const RegionsT *>(&a);
+  const RegionsT * regions_b = dynamic_cast<const RegionsT *>(&b);
+  if (!regions_a || !regions_b || regions_a->RegionCount() != regions_b->RegionCount())
+    return false;
+  for (std::size_t i = 0; i < regions_a->RegionCount(); ++i)
+  {
+    const SIOPointFeature & fa = regions_a->Features()[i];
+    const SIOPointFeature & fb = regions_b->Features()[i];
+    const float values_a[4] = {fa.x(), fa.y(), fa.scale(), fa.orientation()};
+    const float values_b[4] = {fb.x(), fb.y(), fb.scale(), fb.orientation()};
+    if (std::memcmp(values_a, values_b, sizeof(values_a)) != 0
+        || std::memcmp(&regions_a->Descriptors()[i], &regions_b->Descriptors()[i],
+                       sizeof(typename RegionsT::DescriptorT)) != 0)
+      return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+  std::string sImage;
+  int iWidth = 4000, iHeight = 3000;
+  int iRuns = 3;
+  int iThreads = 0;
+
+  cmd.add( make_option('i', sImage, "image") );
+  cmd.add( make_option('w', iWidth, "width") );
+  cmd.add( make_option('h', iHeight, "height") );
+  cmd.add( make_option('r', iRuns, "runs") );
+  cmd.add( make_option('n', iThreads, "threads") );
+
+  try {
+    cmd.process(argc, argv);
+  } catch (const std::string& s) {
+    OPENMVG_LOG_INFO << "Usage: " << argv[0] << '\n'
+      << "[-i|--image] image to use (default: synthetic image)\n"
+      << "[-w|--width] [-h|--height] synthetic image size (default: 4000x3000)\n"
+      << "[-r|--runs] runs per configuration, the median is reported (default: 3)\n"
+      << "[-n|--threads] thread count of the parallel run (default 0: one per core)";
+    OPENMVG_LOG_ERROR << s;
+    return EXIT_FAILURE;
+  }
+
+  Image<unsigned char> image;
+  if (!sImage.empty())
+  {
+    if (!ReadImage(sImage.c_str(), &image))
+    {
+      OPENMVG_LOG_ERROR << "Cannot read the image: " << sImage;
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    image = SyntheticImage(iWidth, iHeight);
+  }
+  iRuns = std::max(1, iRuns);
+  if (iThreads <= 0)
+    iThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#ifndef OPENMVG_USE_OPENMP
+  OPENMVG_LOG_WARNING << "Built without OpenMP: the row blocks run on a single thread.";
+#endif
+
+  bool bIdentical = true;
+  for (const EAKAZE_DESCRIPTOR descriptor : {AKAZE_MSURF, AKAZE_MLDB})
+  {
+    const AKAZE_Image_describer::Params params(AKAZE::Params(), descriptor);
+    std::unique_ptr<AKAZE_Image_describer> stock_describer = AKAZE_Image_describer::create(params, true);
+    AKAZE_RowBlock_Image_describer serial_describer(params, true);
+    serial_describer.SetThreadCount(1);
+    AKAZE_RowBlock_Image_describer parallel_describer(params, true);
+    parallel_describer.SetThreadCount(iThreads);
+
+    std::unique_ptr<Regions> stock, serial, parallel;
+#ifdef OPENMVG_USE_OPENMP
+    omp_set_num_threads(1); // the library describer: its single threaded path
+#endif
+    const double stock_time = MedianTime(iRuns, *stock_describer, image, stock);
+    const double serial_time = MedianTime(iRuns, serial_describer, image, serial);
+    const double parallel_time = MedianTime(iRuns, parallel_describer, image, parallel);
+
+    const bool bMLDB = descriptor == AKAZE_MLDB;
+    const bool bSame = bMLDB
+      ? BitIdentical<AKAZE_Binary_Regions>(*serial, *parallel)
+      : BitIdentical<AKAZE_Float_Regions>(*serial, *parallel);
+    bIdentical = bIdentical && bSame;
+
+    OPENMVG_LOG_INFO
+      << "\nAKAZE " << (bMLDB ? "MLDB" : "MSURF") << " on a " << image.Width() << "x" << image.Height()
+      << " image (median of " << iRuns << " runs):"
+      << "\n stock (1 thread):      " << stock_time << " s, " << stock->RegionCount() << " regions"
+      << "\n row blocks, 1 thread:  " << serial_time << " s, " << serial->RegionCount() << " regions"
+      << "\n row blocks, " << iThreads << " threads: " << parallel_time << " s, " << parallel->RegionCount() << " regions"
+      << "\n speedup " << iThreads << " threads vs 1 thread: " << serial_time / std::max(parallel_time, 1e-9)
+      << "\n speedup " << iThreads << " threads vs stock: " << stock_time / std::max(parallel_time, 1e-9)
+      << "\n 1 thread vs " << iThreads << " threads: " << (bSame ? "bit identical" : "DIFFERENT");
+  }
+
+  return bIdentical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// SIFT_Anatomy description with the SIMD scale space (the ComputeFeatures
+// SIFT_ANATOMY path) versus its scalar path and versus the stock
+// SIFT_Anatomy_Image_describer. Reports the speedup and checks that the
+// regions agree: same keypoints (position within kMaxOffset) and descriptors
+// within kMaxDescriptorDifference per bin.
+//
+//   benchmark_sift_anatomy_simd [-i image] [-w width -h height] [-r runs]
+//                               [-t min_agreement]
+
+#include "openMVG/features/sift/SIFT_Anatomy_Image_Describer.hpp"
+#include "openMVG/image/image_io.hpp"
+#include "openMVG/system/logger.hpp"
+#include "openMVG/system/timer.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+
+#include "sift_anatomy_simd_describer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::image;
+
+// Same keypoint: position and scale within kMaxOffset (the blurs only differ
+// by float rounding). Descriptor bins are quantized on [0, 255].
+static const float kMaxOffset = 0.01f;
+static const int kMaxDescriptorDifference = 2;
+
+// Deterministic textured test image (blobs and corners on a noisy gradient)
+static Image<unsigned char> SyntheticImage(int width, int height)
+{
+  Image<unsigned char> image(width, height);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> noise(0, 12);
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x)
+    {
+      const float blobs = 0.5f + 0.25f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+      const float checker = (((x / 37) + (y / 53)) % 2) ? 0.15f : 0.f;
+      image(y, x) = static_cast<unsigned char>(std::min(255.f, 200.f * (blobs + checker)) + noise(rng) * 0.5f);
+    }
+  return image;
+}
+
+static double MedianTime(int runs, Image_describer & describer, const Image<unsigned char> & image,
+                         std::unique_ptr<Regions> & regions)
+{
+  std::vector<double> timings;
+  for (int run = 0; run < runs; ++run)
+  {
+    system::Timer timer;
+    regions = describer.Describe(image, nullptr);
+    timings.push_back(timer.elapsed());
+  }
+  std::sort(timings.begin(), timings.end());
+  return timings[timings.size() / 2];
+}
+
+struct Agreement
+{
+  double fraction = 1.0;            // matched regions / max(region counts)
+  int max_descriptor_difference = 0; // over the matched regions
+};
+
+/// Pair each reference region with a region at the same position, scale and
+/// orientation, and compare their descriptors bin per bin
+static Agreement Compare(const SIFT_Regions & reference, const SIFT_Regions & other)
+{
+  const auto & reference_features = reference.Features();
+  const auto & other_features = other.Features();
+  std::vector<std::size_t> order(other_features.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+  {
+    return other_features[a].x() < other_features[b].x();
+  });
+
+  Agreement agreement;
+  std::size_t matched = 0;
+  std::vector<bool> used(other_features.size(), false);
+  for (std::size_t i = 0; i < reference_features.size(); ++i)
+  {
+    const SIOPointFeature & feature = reference_features[i];
+    auto it = std::lower_bound(order.cbegin(), order.cend(), feature.x() - kMaxOffset,
+      [&](std::size_t j, float x) { return other_features[j].x() < x; });
+    int best_difference = -1;
+    std::size_t best = 0;
+    for (; it != order.cend() && other_features[*it].x() <= feature.x() + kMaxOffset; ++it)
+    {
+      const SIOPointFeature & candidate = other_features[*it];
+      if (used[*it]
+          || std::abs(candidate.y() - feature.y()) > kMaxOffset
+          || std::abs(candidate.scale() - feature.scale()) > kMaxOffset
+          || std::abs(candidate.orientation() - feature.orientation()) > kMaxOffset)
+        continue;
+      const int difference = static_cast<int>((reference.Descriptors()[i].cast<int>()
+        - other.Descriptors()[*it].cast<int>()).cwiseAbs().maxCoeff());
+      if (best_difference < 0 || difference < best_difference)
+      {
+        best_difference = difference;
+        best = *it;
+      }
+    }
+    if (best_difference < 0)
+      continue;
+    used[best] = true;
+    ++matched;
+    agreement.max_descriptor_difference = std::max(agreement.max_descriptor_difference, best_difference);
+  }
+  const std::size_t count = std::max(reference_features.size(), other_features.size());
+  agreement.fraction = count == 0 ? 1.0 : matched / static_cast<double>(count);
+  return agreement;
+}
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+  std::string sImage;
+  int iWidth = 4000, iHeight = 3000;
+  int iRuns = 3;
+  // Extrema at the peak or edge threshold can appear or vanish with rounding
+  double dMinAgreement = 0.99;
+
+  cmd.add( make_option('i', sImage, "image") );
+  cmd.add( make_option('w', iWidth, "width") );
+  cmd.add( make_option('h', iHeight, "height") );
+  cmd.add( make_option('r', iRuns, "runs") );
+  cmd.add( make_option('t', dMinAgreement, "min_agreement") );
+
+  try {
+    cmd.process(argc, argv);
+  } catch (const std::string& s) {
+    OPENMVG_LOG_INFO << "Usage: " << argv[0] << '\n'
+      << "[-i|--image] image to use (default: synthetic image)\n"
+      << "[-w|--width] [-h|--height] synthetic image size (default: 4000x3000)\n"
+      << "[-r|--runs] runs per configuration, the median is reported (default: 3)\n"
+      << "[-t|--min_agreement] tolerance: fraction of the regions found by both paths (default: 0.99)";
+    OPENMVG_LOG_ERROR << s;
+    return EXIT_FAILURE;
+  }
+
+  Image<unsigned char> image;
+  if (!sImage.empty())
+  {
+    if (!ReadImage(sImage.c_str(), &image))
+    {
+      OPENMVG_LOG_ERROR << "Cannot read the image: " << sImage;
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    image = SyntheticImage(iWidth, iHeight);
+  }
+  iRuns = std::max(1, iRuns);
+
+  const sift_simd::SimdLevel level = sift_simd::ActiveSimdLevel();
+  SIFT_Anatomy_Image_describer stock_describer;
+  SIFT_Anatomy_SIMD_Image_describer scalar_describer(SIFT_Anatomy_Image_describer::Params(), sift_simd::SimdLevel::SCALAR);
+  SIFT_Anatomy_SIMD_Image_describer simd_describer(SIFT_Anatomy_Image_describer::Params(), level);
+
+  std::unique_ptr<Regions> stock, scalar, simd;
+  const double stock_time = MedianTime(iRuns, stock_describer, image, stock);
+  const double scalar_time = MedianTime(iRuns, scalar_describer, image, scalar);
+  const double simd_time = MedianTime(iRuns, simd_describer, image, simd);
+
+  const Agreement simd_vs_scalar = Compare(
+    *dynamic_cast<const SIFT_Regions *>(scalar.get()), *dynamic_cast<const SIFT_Regions *>(simd.get()));
+  const Agreement scalar_vs_stock = Compare(
+    *dynamic_cast<const SIFT_Regions *>(stock.get()), *dynamic_cast<const SIFT_Regions *>(scalar.get()));
+  const bool within_tolerance =
+    simd_vs_scalar.fraction >= dMinAgreement
+    && simd_vs_scalar.max_descriptor_difference <= kMaxDescriptorDifference
+    && scalar_vs_stock.fraction >= dMinAgreement
+    && scalar_vs_stock.max_descriptor_difference <= kMaxDescriptorDifference;
+
+  OPENMVG_LOG_INFO
+    << "\nSIFT_Anatomy on a " << image.Width() << "x" << image.Height()
+    << " image (median of " << iRuns << " runs):"
+    << "\n stock:    " << stock_time << " s, " << stock->RegionCount() << " regions"
+    << "\n scalar:   " << scalar_time << " s, " << scalar->RegionCount() << " regions"
+    << "\n " << sift_simd::SimdLevelName(level) << ": " << simd_time << " s, " << simd->RegionCount() << " regions"
+    << "\n speedup vs stock: " << stock_time / std::max(simd_time, 1e-9)
+    << "\n " << sift_simd::SimdLevelName(level) << " vs scalar: " << simd_vs_scalar.fraction
+    << " of the regions, max descriptor bin difference " << simd_vs_scalar.max_descriptor_difference
+    << "\n scalar vs stock: " << scalar_vs_stock.fraction
+    << " of the regions, max descriptor bin difference " << scalar_vs_stock.max_descriptor_difference
+    << "\n tolerance: " << (within_tolerance ? "ok" : "EXCEEDED")
+    << " (min " << dMinAgreement << " of the regions, max bin difference " << kMaxDescriptorDifference << ")";
+
+  return within_tolerance ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,116 @@
+"""Startup latency of the Products binaries.
+
+Two measures, N runs each:
+- usage: each binary is started without argument (it parses the command
+  line, prints its usage and exits). This is the bare process startup cost:
+  dynamic loading and static initialisation.
+- listing: a real SfMInit_ImageListing run on an image directory (EXIF and
+  sensor database lookups, sfm_data export), once without and once with a
+  Python hook module, so the interpreter start is only paid when a hook is
+  requested.
+
+    python benchmark_startup.py --bin_dir <build>/bin [--runs 20]
+        [--images <image dir> --sensor_db <sensor_width_camera_database.txt>]
+"""
+import argparse
+import os
+import shutil
+import statistics
+import subprocess
+import tempfile
+import time
+
+BINARIES = [
+    'openMVG_main_SfMInit_ImageListing',
+    'openMVG_main_ComputeFeatures',
+    'openMVG_main_PairGenerator',
+    'openMVG_main_ComputeMatches',
+    'openMVG_main_GeometricFilter',
+    'openMVG_main_SfM',
+]
+
+HOOK_MODULE = 'benchmark_startup_hook'
+
+
+def binary_path(bin_dir, name):
+    return os.path.join(bin_dir, name + ('.exe' if os.name == 'nt' else ''))
+
+
+def time_runs(command, runs, env=None, setup=None):
+    timings = []
+    returncode = 0
+    for _ in range(runs):
+        if setup:
+            setup()
+        start = time.perf_counter()
+        returncode = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+                                    env=env).returncode
+        timings.append((time.perf_counter() - start) * 1000.0)
+    return timings, returncode
+
+
+def print_header(title):
+    print(f"{title:<48}{'median (ms)':>14}{'min (ms)':>12}{'max (ms)':>12}")
+
+
+def print_row(name, timings):
+    print(f"{name:<48}{statistics.median(timings):>14.2f}{min(timings):>12.2f}{max(timings):>12.2f}")
+
+
+def benchmark_listing(args):
+    listing = binary_path(args.bin_dir, BINARIES[0])
+    if not os.path.isfile(listing):
+        print(f"{BINARIES[0]:<48}{'not built':>14}")
+        return
+    work_dir = tempfile.mkdtemp(prefix='omvg_startup_')
+    try:
+        output_dir = os.path.join(work_dir, 'matches')
+        command = [listing, '-i', args.images, '-o', output_dir, '-d', args.sensor_db]
+
+        def reset():
+            # A complete run every time, not an incremental update
+            shutil.rmtree(output_dir, ignore_errors=True)
+
+        # Empty hook: the difference is the interpreter start and the import
+        with open(os.path.join(work_dir, HOOK_MODULE + '.py'), 'w') as hook:
+            hook.write('def on_listing_done(sfm_data_file):\n    pass\n')
+        env = dict(os.environ)
+        env['PYTHONPATH'] = os.pathsep.join(filter(None, [work_dir, env.get('PYTHONPATH')]))
+
+        print_header('listing ' + args.images)
+        for label, extra in (('without hook', []), ('with --python_hook', ['-y', HOOK_MODULE])):
+            timings, returncode = time_runs(command + extra, args.runs, env, reset)
+            if returncode != 0:
+                print(f"{label:<48}{'failed, exit code ' + str(returncode):>14}")
+                continue
+            print_row(label, timings)
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--bin_dir', required=True, help='directory of the built binaries')
+    parser.add_argument('--runs', type=int, default=20, help='number of runs per measure')
+    parser.add_argument('--images', help='image directory of the real listing run')
+    parser.add_argument('--sensor_db', help='camera sensor width database of the real listing run'
+                        ' (required with --images: the listing fails without -d)')
+    args = parser.parse_args()
+    if args.images and not args.sensor_db:
+        parser.error('--sensor_db is required with --images')
+
+    print_header('usage (no argument)')
+    for name in BINARIES:
+        path = binary_path(args.bin_dir, name)
+        if not os.path.isfile(path):
+            print(f"{name:<48}{'not built':>14}")
+            continue
+        print_row(name, time_runs([path], args.runs)[0])
+
+    if args.images:
+        print()
+        benchmark_listing(args)
+
+
+if __name__ == '__main__':
+    main()
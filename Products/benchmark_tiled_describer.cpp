@@ -0,0 +1,231 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Intra-image parallel description of a large image: the stock describer on
+// the whole image (its own loops, 1 image at a time) versus the same
+// describer on overlapping tiles described in parallel (DescribeTiled, the
+// ComputeFeatures -T path). Reports the speedup and checks that the tiled
+// regions stay within tolerance of the stock ones, and that they do not
+// depend on the thread count.
+//
+//   benchmark_tiled_describer [-i image] [-m AKAZE_FLOAT|AKAZE_MLDB|SIFT_ANATOMY]
+//                             [-T tile_size] [-n threads] [-r runs]
+
+#include "openMVG/features/akaze/image_describer_akaze.hpp"
+#include "openMVG/features/sift/SIFT_Anatomy_Image_Describer.hpp"
+#include "openMVG/image/image_io.hpp"
+#include "openMVG/system/logger.hpp"
+#include "openMVG/system/timer.hpp"
+
+#include "third_party/cmdLine/cmdLine.h"
+
+#include "image_tiles.hpp"
+#include "system_resources.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace openMVG;
+using namespace openMVG::features;
+using namespace openMVG::image;
+
+// A stock region is repeated when a tiled region lies within kMaxOffset
+// pixels and its descriptor is closer than the nearest other stock
+// descriptor (i.e. nearest neighbour matching pairs them).
+static const float kMaxOffset = 1.f;
+static const std::size_t kMaxCheckedRegions = 2000;
+
+// Deterministic textured test image (blobs and corners on a noisy gradient)
+static Image<unsigned char> SyntheticImage(int width, int height)
+{
+  Image<unsigned char> image(width, height);
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> noise(0, 12);
+  for (int y = 0; y < height; ++y)
+    for (int x = 0; x < width; ++x)
+    {
+      const float blobs = 0.5f + 0.25f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+      const float checker = (((x / 37) + (y / 53)) % 2) ? 0.15f : 0.f;
+      image(y, x) = static_cast<unsigned char>(std::min(255.f, 200.f * (blobs + checker)) + noise(rng) * 0.5f);
+    }
+  return image;
+}
+
+static std::unique_ptr<Image_describer> CreateDescriber(const std::string & sMethod)
+{
+  if (sMethod == "AKAZE_FLOAT")
+    return AKAZE_Image_describer::create(AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MSURF));
+  if (sMethod == "AKAZE_MLDB")
+    return AKAZE_Image_describer::create(AKAZE_Image_describer::Params(AKAZE::Params(), AKAZE_MLDB));
+  if (sMethod == "SIFT_ANATOMY")
+    return std::unique_ptr<Image_describer>(new SIFT_Anatomy_Image_describer);
+  return nullptr;
+}
+
+template <typename DescribeFunctor>
+static double MedianTime(int runs, DescribeFunctor describe, std::unique_ptr<Regions> & regions)
+{
+  std::vector<double> timings;
+  for (int run = 0; run < runs; ++run)
+  {
+    system::Timer timer;
+    regions = describe();
+    timings.push_back(timer.elapsed());
+  }
+  std::sort(timings.begin(), timings.end());
+  return timings[timings.size() / 2];
+}
+
+/// Fraction of the (sampled) stock regions repeated by the tiled regions
+static double Repeatability(const Regions & stock, const Regions & tiled)
+{
+  const std::size_t step = std::max<std::size_t>(1, stock.RegionCount() / kMaxCheckedRegions);
+  std::size_t checked = 0, repeated = 0;
+  for (std::size_t i = 0; i < stock.RegionCount(); i += step)
+  {
+    ++checked;
+    const Vec2 position = stock.GetRegionPosition(i);
+    double nearest_other = std::numeric_limits<double>::max();
+    for (std::size_t j = 0; j < stock.RegionCount(); ++j)
+    {
+      if (j != i)
+        nearest_other = std::min(nearest_other, stock.SquaredDescriptorDistance(i, &stock, j));
+    }
+    for (std::size_t j = 0; j < tiled.RegionCount(); ++j)
+    {
+      const Vec2 tiled_position = tiled.GetRegionPosition(j);
+      if (std::abs(tiled_position(0) - position(0)) <= kMaxOffset
+          && std::abs(tiled_position(1) - position(1)) <= kMaxOffset
+          && stock.SquaredDescriptorDistance(i, &tiled, j) < nearest_other)
+      {
+        ++repeated;
+        break;
+      }
+    }
+  }
+  return checked == 0 ? 1.0 : repeated / static_cast<double>(checked);
+}
+
+static bool SameRegions(const Regions & a, const Regions & b)
+{
+  if (a.RegionCount() != b.RegionCount())
+    return false;
+  for (std::size_t i = 0; i < a.RegionCount(); ++i)
+  {
+    if (a.GetRegionPosition(i) != b.GetRegionPosition(i)
+        || a.SquaredDescriptorDistance(i, &b, i) != 0.0)
+      return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+  std::string sImage;
+  std::string sMethod = "AKAZE_FLOAT";
+  int iWidth = 6000, iHeight = 4000;
+  int iTileSize = 1024;
+  int iNumThreads = 0;
+  int iRuns = 3;
+  double dMinRepeatability = 0.8;
+
+  cmd.add( make_option('i', sImage, "image") );
+  cmd.add( make_option('m', sMethod, "describerMethod") );
+  cmd.add( make_option('w', iWidth, "width") );
+  cmd.add( make_option('h', iHeight, "height") );
+  cmd.add( make_option('T', iTileSize, "tile_size") );
+  cmd.add( make_option('n', iNumThreads, "numThreads") );
+  cmd.add( make_option('r', iRuns, "runs") );
+  cmd.add( make_option('t', dMinRepeatability, "min_repeatability") );
+
+  try {
+    cmd.process(argc, argv);
+  } catch (const std::string& s) {
+    OPENMVG_LOG_INFO << "Usage: " << argv[0] << '\n'
+      << "[-i|--image] image to use (default: synthetic image)\n"
+      << "[-m|--describerMethod] AKAZE_FLOAT (default), AKAZE_MLDB or SIFT_ANATOMY\n"
+      << "[-w|--width] [-h|--height] synthetic image size (default: 6000x4000)\n"
+      << "[-T|--tile_size] tile size, the border is tile_size / 4 (default: 1024)\n"
+      << "[-n|--numThreads] threads of the tiled path (default: all cores)\n"
+      << "[-r|--runs] runs per configuration, the median is reported (default: 3)\n"
+      << "[-t|--min_repeatability] tolerance: fraction of the whole image regions the tiles must repeat (default: 0.8)";
+    OPENMVG_LOG_ERROR << s;
+    return EXIT_FAILURE;
+  }
+
+  Image<unsigned char> image;
+  if (!sImage.empty())
+  {
+    if (!ReadImage(sImage.c_str(), &image))
+    {
+      OPENMVG_LOG_ERROR << "Cannot read the image: " << sImage;
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    image = SyntheticImage(iWidth, iHeight);
+  }
+  std::unique_ptr<Image_describer> image_describer = CreateDescriber(sMethod);
+  if (!image_describer || iTileSize <= 0)
+  {
+    OPENMVG_LOG_ERROR << "Invalid describer or tile size.";
+    return EXIT_FAILURE;
+  }
+  const int thread_count = iNumThreads > 0 ? iNumThreads : static_cast<int>(system::GetCoreCount());
+  const int border = iTileSize / 4;
+  iRuns = std::max(1, iRuns);
+
+  // Stock path: the whole image, with the describer's own parallel loops
+  std::unique_ptr<Regions> stock, tiled, tiled_serial;
+#ifdef OPENMVG_USE_OPENMP
+  omp_set_num_threads(thread_count);
+#endif
+  const double stock_time = MedianTime(iRuns, [&]()
+  {
+    return image_describer->Describe(image, nullptr);
+  }, stock);
+  const double tiled_time = MedianTime(iRuns, [&]()
+  {
+    return DescribeTiled(*image_describer, image, nullptr, iTileSize, border, thread_count);
+  }, tiled);
+  MedianTime(1, [&]()
+  {
+    return DescribeTiled(*image_describer, image, nullptr, iTileSize, border, 1);
+  }, tiled_serial);
+  if (!stock || !tiled || !tiled_serial)
+  {
+    OPENMVG_LOG_ERROR << "The " << sMethod << " regions cannot be described on tiles.";
+    return EXIT_FAILURE;
+  }
+
+  const double repeatability = Repeatability(*stock, *tiled);
+  const bool deterministic = SameRegions(*tiled, *tiled_serial);
+  const bool within_tolerance = repeatability >= dMinRepeatability;
+
+  OPENMVG_LOG_INFO
+    << "\n" << sMethod << " on a " << image.Width() << "x" << image.Height() << " image"
+    << " (tiles " << iTileSize << " + " << border << " border, median of " << iRuns << " runs):"
+    << "\n whole image:           " << stock_time << " s, " << stock->RegionCount() << " regions"
+    << "\n tiles, " << thread_count << " thread(s): " << tiled_time << " s, " << tiled->RegionCount() << " regions"
+    << "\n speedup:               " << stock_time / std::max(tiled_time, 1e-9)
+    << "\n repeatability:         " << repeatability << " (min " << dMinRepeatability << ")"
+    << "\n 1 thread vs " << thread_count << " threads: " << (deterministic ? "identical" : "DIFFERENT")
+    << "\n tolerance: " << (within_tolerance ? "ok" : "EXCEEDED");
+
+  return (within_tolerance && deterministic) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
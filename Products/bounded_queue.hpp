@@ -0,0 +1,123 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_BOUNDED_QUEUE_HPP
+#define PRODUCTS_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace openMVG {
+namespace system {
+
+/// Statistics of a BoundedQueue, used to see which stage of a pipeline waits
+/// for the other one.
+struct BoundedQueueStats
+{
+  std::size_t capacity = 0;
+  std::size_t pushed = 0;
+  std::size_t max_depth = 0;
+  double mean_depth = 0.0;     // depth seen by the pushed items
+  double push_wait_s = 0.0;    // producers blocked on a full queue
+  double pop_wait_s = 0.0;     // consumers blocked on an empty queue
+};
+
+/// Multi producer / multi consumer FIFO with a maximal depth.
+/// Push blocks while the queue is full, Pop blocks while it is empty.
+/// Once closed, Push fails and Pop drains the remaining items then fails.
+template <typename T>
+class BoundedQueue
+{
+public:
+  explicit BoundedQueue(std::size_t capacity)
+    : capacity_(std::max<std::size_t>(1, capacity))
+  {}
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue & operator=(const BoundedQueue &) = delete;
+
+  bool Push(T item)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (items_.size() >= capacity_ && !closed_)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      not_full_.wait(lock, [this] { return items_.size() < capacity_ || closed_; });
+      push_wait_ += std::chrono::steady_clock::now() - start;
+    }
+    if (closed_)
+      return false;
+    items_.push_back(std::move(item));
+    ++pushed_;
+    depth_sum_ += items_.size();
+    max_depth_ = std::max(max_depth_, items_.size());
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+  }
+
+  bool Pop(T & item)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (items_.empty() && !closed_)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+      pop_wait_ += std::chrono::steady_clock::now() - start;
+    }
+    if (items_.empty())
+      return false;
+    item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return true;
+  }
+
+  /// No more items will be pushed: wake up all the waiting threads
+  void Close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  BoundedQueueStats Stats() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BoundedQueueStats stats;
+    stats.capacity = capacity_;
+    stats.pushed = pushed_;
+    stats.max_depth = max_depth_;
+    stats.mean_depth = pushed_ > 0 ? static_cast<double>(depth_sum_) / pushed_ : 0.0;
+    stats.push_wait_s = std::chrono::duration<double>(push_wait_).count();
+    stats.pop_wait_s = std::chrono::duration<double>(pop_wait_).count();
+    return stats;
+  }
+
+private:
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_, not_empty_;
+  std::deque<T> items_;
+  bool closed_ = false;
+
+  std::size_t pushed_ = 0, max_depth_ = 0, depth_sum_ = 0;
+  std::chrono::steady_clock::duration push_wait_{0}, pop_wait_{0};
+};
+
+} // namespace system
+} // namespace openMVG
+
+#endif // PRODUCTS_BOUNDED_QUEUE_HPP
@@ -0,0 +1,309 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_COMPACT_DESCRIPTORS_HPP
+#define PRODUCTS_COMPACT_DESCRIPTORS_HPP
+
+#include "openMVG/features/image_describer.hpp"
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/system/logger.hpp"
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/memory.hpp>
+#include <cereal/types/polymorphic.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openMVG {
+namespace features {
+
+/// Compact encodings of the descriptors, chosen at extraction and kept in
+/// image_describer.json. Each encoding has its own regions type, so the
+/// regions_type of image_describer.json and the records of a regions pack
+/// tell the encodings apart; the descriptors are uint8 scalar descriptors
+/// that the matchers and the guided geometric filtering read directly:
+/// - ROOTSIFT_U8: RootSIFT (sqrt of the L1 normalized SIFT) quantized on
+///   uint8, stored as RootSIFT_Regions (128 bytes, better L2 matching than SIFT)
+/// - PCA64: RootSIFT projected on its 64 principal components and quantized
+///   on uint8, stored as PCA64_Regions (64 bytes); the mean, the basis and the
+///   quantization scale are learnt on a sample of the images and serialized
+///   with the describer
+enum class EDescriptorEncoding
+{
+  RAW = 0,
+  ROOTSIFT_U8,
+  PCA64
+};
+
+inline bool StringToDescriptorEncoding(const std::string & name, EDescriptorEncoding & encoding)
+{
+  if (name == "RAW")
+    encoding = EDescriptorEncoding::RAW;
+  else if (name == "ROOTSIFT_U8")
+    encoding = EDescriptorEncoding::ROOTSIFT_U8;
+  else if (name == "PCA64")
+    encoding = EDescriptorEncoding::PCA64;
+  else
+    return false;
+  return true;
+}
+
+inline std::string DescriptorEncodingToString(EDescriptorEncoding encoding)
+{
+  switch (encoding)
+  {
+    case EDescriptorEncoding::ROOTSIFT_U8: return "ROOTSIFT_U8";
+    case EDescriptorEncoding::PCA64: return "PCA64";
+    default: return "RAW";
+  }
+}
+
+/// RootSIFT descriptors: same layout, Type_id and metric as SIFT_Regions,
+/// but a regions type of their own
+class RootSIFT_Regions : public SIFT_Regions
+{
+public:
+  Regions * EmptyClone() const override { return new RootSIFT_Regions; }
+
+  template <class Archive>
+  void serialize(Archive &) {}
+};
+
+/// PCA64 descriptors: 64 uint8 bins, L2 metric
+class PCA64_Regions : public Scalar_Regions<SIOPointFeature, unsigned char, 64>
+{
+public:
+  Regions * EmptyClone() const override { return new PCA64_Regions; }
+
+  template <class Archive>
+  void serialize(Archive &) {}
+};
+
+/// Image_describer wrapping a SIFT describer and encoding its descriptors
+class Compact_Image_describer : public Image_describer
+{
+public:
+  static const int kPCADimension = 64;
+
+  Compact_Image_describer() = default;
+
+  Compact_Image_describer
+  (
+    std::unique_ptr<Image_describer> inner,
+    EDescriptorEncoding encoding
+  )
+    : inner_(std::move(inner)), encoding_(encoding)
+  {}
+
+  /// The encodings apply to the SIFT regions (SIFT and SIFT_ANATOMY)
+  static bool IsEncodable(const Image_describer & inner)
+  {
+    return dynamic_cast<const SIFT_Regions *>(inner.Allocate().get()) != nullptr;
+  }
+
+  const Image_describer & Inner() const { return *inner_; }
+  Image_describer & Inner() { return *inner_; }
+  EDescriptorEncoding Encoding() const { return encoding_; }
+
+  /// PCA64 needs its projection before the first Describe
+  bool NeedsTraining() const
+  {
+    return encoding_ == EDescriptorEncoding::PCA64 && pca_basis_.empty();
+  }
+
+  bool Set_configuration_preset(EDESCRIBER_PRESET preset) override
+  {
+    return inner_->Set_configuration_preset(preset);
+  }
+
+  std::unique_ptr<Regions> Describe
+  (
+    const image::Image<unsigned char> & image,
+    const image::Image<unsigned char> * mask = nullptr
+  ) override
+  {
+    std::unique_ptr<Regions> regions = inner_->Describe(image, mask);
+    if (!regions || encoding_ == EDescriptorEncoding::RAW)
+      return regions;
+    return Encode(*regions);
+  }
+
+  std::unique_ptr<Regions> Allocate() const override
+  {
+    if (encoding_ == EDescriptorEncoding::PCA64)
+      return std::unique_ptr<Regions>(new PCA64_Regions);
+    if (encoding_ == EDescriptorEncoding::ROOTSIFT_U8)
+      return std::unique_ptr<Regions>(new RootSIFT_Regions);
+    return inner_->Allocate();
+  }
+
+  /// SIFT descriptors of an image, before encoding (PCA training samples)
+  std::unique_ptr<Regions> DescribeRaw
+  (
+    const image::Image<unsigned char> & image,
+    const image::Image<unsigned char> * mask = nullptr
+  )
+  {
+    return inner_->Describe(image, mask);
+  }
+
+  /// Learn the PCA64 mean and basis from sample SIFT regions
+  /// (at most max_samples descriptors, taken evenly)
+  bool TrainPCA
+  (
+    const std::vector<const Regions *> & samples,
+    std::size_t max_samples = 200000
+  )
+  {
+    std::size_t descriptor_count = 0;
+    for (const Regions * regions : samples)
+      if (auto * sift = dynamic_cast<const SIFT_Regions *>(regions))
+        descriptor_count += sift->Descriptors().size();
+    if (descriptor_count < static_cast<std::size_t>(kPCADimension))
+      return false;
+    const std::size_t step = std::max<std::size_t>(1, descriptor_count / max_samples);
+
+    Eigen::MatrixXd data(128, (descriptor_count + step - 1) / step);
+    Eigen::Index column = 0;
+    std::size_t index = 0;
+    for (const Regions * regions : samples)
+    {
+      auto * sift = dynamic_cast<const SIFT_Regions *>(regions);
+      if (!sift)
+        continue;
+      for (const auto & descriptor : sift->Descriptors())
+      {
+        if (index++ % step != 0 || column >= data.cols())
+          continue;
+        const std::vector<float> root_sift = RootSIFT(descriptor);
+        for (int d = 0; d < 128; ++d)
+          data(d, column) = root_sift[d];
+        ++column;
+      }
+    }
+    data.conservativeResize(Eigen::NoChange, column);
+
+    const Eigen::VectorXd mean = data.rowwise().mean();
+    data.colwise() -= mean;
+    const Eigen::MatrixXd covariance = data * data.transpose() / static_cast<double>(std::max<Eigen::Index>(1, column - 1));
+    const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(covariance);
+    if (solver.info() != Eigen::Success)
+      return false;
+
+    // Eigen values are sorted in increasing order: keep the last 64 vectors
+    pca_mean_.assign(mean.data(), mean.data() + 128);
+    pca_basis_.resize(kPCADimension * 128);
+    for (int k = 0; k < kPCADimension; ++k)
+      for (int d = 0; d < 128; ++d)
+        pca_basis_[k * 128 + d] = static_cast<float>(solver.eigenvectors()(d, 127 - k));
+    // One scale for all the components (the L2 distances are only scaled):
+    // +/- 4 standard deviations of the first component span the uint8 range
+    pca_scale_ = static_cast<float>(127.5 / (4.0 * std::sqrt(std::max(solver.eigenvalues()(127), 1e-12))));
+    const double total_variance = solver.eigenvalues().sum();
+    OPENMVG_LOG_INFO << "PCA64 learnt on " << column << " descriptors, "
+      << 100.0 * solver.eigenvalues().tail(kPCADimension).sum() / std::max(total_variance, 1e-12)
+      << "% of the variance kept";
+    return true;
+  }
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    int encoding = static_cast<int>(encoding_);
+    ar(cereal::make_nvp("inner", inner_),
+       cereal::make_nvp("encoding", encoding),
+       cereal::make_nvp("pca_mean", pca_mean_),
+       cereal::make_nvp("pca_basis", pca_basis_),
+       cereal::make_nvp("pca_scale", pca_scale_));
+    encoding_ = static_cast<EDescriptorEncoding>(encoding);
+  }
+
+private:
+  /// L1 normalization then square root: unit L2 norm
+  template <typename DescriptorT>
+  static std::vector<float> RootSIFT(const DescriptorT & descriptor)
+  {
+    std::vector<float> root_sift(128);
+    float l1 = 0.f;
+    for (int d = 0; d < 128; ++d)
+      l1 += static_cast<float>(descriptor[d]);
+    for (int d = 0; d < 128; ++d)
+      root_sift[d] = l1 > 0.f ? std::sqrt(static_cast<float>(descriptor[d]) / l1) : 0.f;
+    return root_sift;
+  }
+
+  std::unique_ptr<Regions> Encode(const Regions & regions) const
+  {
+    auto * sift = dynamic_cast<const SIFT_Regions *>(&regions);
+    if (!sift)
+    {
+      OPENMVG_LOG_ERROR << "Compact descriptors: the regions are not SIFT regions.";
+      return nullptr;
+    }
+    if (encoding_ == EDescriptorEncoding::ROOTSIFT_U8)
+    {
+      // Same scale as the SIFT quantization (512 x unit vector, clamped)
+      std::unique_ptr<RootSIFT_Regions> encoded(new RootSIFT_Regions);
+      encoded->Features() = sift->Features();
+      encoded->Descriptors().resize(sift->Descriptors().size());
+      for (std::size_t i = 0; i < sift->Descriptors().size(); ++i)
+      {
+        const std::vector<float> root_sift = RootSIFT(sift->Descriptors()[i]);
+        for (int d = 0; d < 128; ++d)
+          encoded->Descriptors()[i][d] = static_cast<unsigned char>(std::min(255.f, std::round(512.f * root_sift[d])));
+      }
+      return std::unique_ptr<Regions>(std::move(encoded));
+    }
+
+    // PCA64 on RootSIFT
+    if (pca_basis_.size() != static_cast<std::size_t>(kPCADimension * 128) || pca_mean_.size() != 128)
+    {
+      OPENMVG_LOG_ERROR << "Compact descriptors: the PCA64 projection is not learnt.";
+      return nullptr;
+    }
+    std::unique_ptr<PCA64_Regions> encoded(new PCA64_Regions);
+    encoded->Features() = sift->Features();
+    encoded->Descriptors().resize(sift->Descriptors().size());
+    const Eigen::Map<const Eigen::Matrix<float, kPCADimension, 128, Eigen::RowMajor>> basis(pca_basis_.data());
+    const Eigen::Map<const Eigen::Matrix<float, 128, 1>> mean(pca_mean_.data());
+    for (std::size_t i = 0; i < sift->Descriptors().size(); ++i)
+    {
+      const std::vector<float> root_sift = RootSIFT(sift->Descriptors()[i]);
+      const Eigen::Matrix<float, kPCADimension, 1> projected =
+        basis * (Eigen::Map<const Eigen::Matrix<float, 128, 1>>(root_sift.data()) - mean);
+      for (int k = 0; k < kPCADimension; ++k)
+        encoded->Descriptors()[i][k] = static_cast<unsigned char>(
+          std::min(255.f, std::max(0.f, std::round(127.5f + pca_scale_ * projected(k)))));
+    }
+    return std::unique_ptr<Regions>(std::move(encoded));
+  }
+
+  std::unique_ptr<Image_describer> inner_;
+  EDescriptorEncoding encoding_ = EDescriptorEncoding::RAW;
+  std::vector<float> pca_mean_;   // 128
+  std::vector<float> pca_basis_;  // 64 x 128, row major
+  float pca_scale_ = 1.f;         // uint8 bin = 127.5 + scale x component
+};
+
+} // namespace features
+} // namespace openMVG
+
+CEREAL_REGISTER_TYPE_WITH_NAME(openMVG::features::RootSIFT_Regions, "RootSIFT_Regions");
+CEREAL_REGISTER_POLYMORPHIC_RELATION(openMVG::features::Regions, openMVG::features::RootSIFT_Regions)
+CEREAL_REGISTER_TYPE_WITH_NAME(openMVG::features::PCA64_Regions, "PCA64_Regions");
+CEREAL_REGISTER_POLYMORPHIC_RELATION(openMVG::features::Regions, openMVG::features::PCA64_Regions)
+CEREAL_REGISTER_TYPE_WITH_NAME(openMVG::features::Compact_Image_describer, "Compact_Image_describer");
+CEREAL_REGISTER_POLYMORPHIC_RELATION(openMVG::features::Image_describer, openMVG::features::Compact_Image_describer)
+
+#endif // PRODUCTS_COMPACT_DESCRIPTORS_HPP
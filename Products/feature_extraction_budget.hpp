@@ -0,0 +1,176 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_FEATURE_EXTRACTION_BUDGET_HPP
+#define PRODUCTS_FEATURE_EXTRACTION_BUDGET_HPP
+
+#include "openMVG/features/akaze/image_describer_akaze.hpp"
+#include "openMVG/features/image_describer.hpp"
+#include "openMVG/features/sift/SIFT_Anatomy_Image_Describer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace openMVG {
+namespace features {
+
+/// Rough peak working set of Describe, in bytes per input pixel
+/// (scale space, gradients & temporary images, for the largest octave and
+/// the smaller ones).
+inline double DescriberBytesPerPixel
+(
+  const Image_describer & image_describer,
+  EDESCRIBER_PRESET preset
+)
+{
+  // The image is upsampled twice before the first octave (delta_min = 0.5)
+  if (dynamic_cast<const SIFT_Anatomy_Image_describer *>(&image_describer))
+    return 4.0 * 125.0;
+  // Non linear scale space: 4 float images per evolution, no upsampling
+  if (dynamic_cast<const AKAZE_Image_describer *>(&image_describer))
+    return 110.0;
+  // SIFT (VLFeat): the ULTRA preset starts at octave -1 (upsampled image)
+  return (preset == ULTRA_PRESET) ? 4.0 * 96.0 : 96.0;
+}
+
+/// Peak memory used to describe a width x height image: the decoded
+/// grayscale image, its mask and the describer working set.
+inline std::uint64_t EstimateDescribeMemory
+(
+  std::uint64_t width,
+  std::uint64_t height,
+  double describer_bytes_per_pixel
+)
+{
+  return static_cast<std::uint64_t>(width * height * (2.0 + describer_bytes_per_pixel));
+}
+
+/// Split of the cores between the images described concurrently and the
+/// parallel regions inside a describer (nested OpenMP).
+struct ThreadBudget
+{
+  unsigned int image_threads = 1;
+  unsigned int describer_threads = 1;
+};
+
+/// Default parallelism of the feature extraction.
+/// - requested_threads > 0: the user count of concurrent images is kept,
+/// - otherwise one image per core, limited by the image count and by the
+///   number of largest images fitting in the available memory.
+/// The remaining cores are given to the describers, so a few large images
+/// still use the whole machine.
+inline ThreadBudget ComputeThreadBudget
+(
+  unsigned int requested_threads,
+  std::size_t image_count,
+  std::uint64_t peak_image_memory,
+  std::uint64_t available_memory, // 0: unknown
+  unsigned int core_count
+)
+{
+  ThreadBudget budget;
+  core_count = std::max(1u, core_count);
+  if (requested_threads > 0)
+  {
+    budget.image_threads = requested_threads;
+  }
+  else
+  {
+    std::uint64_t image_threads = core_count;
+    image_threads = std::min<std::uint64_t>(image_threads, std::max<std::size_t>(1, image_count));
+    if (available_memory > 0 && peak_image_memory > 0)
+    {
+      // Keep some headroom for the allocator & the rest of the process
+      const std::uint64_t usable_memory = available_memory / 10 * 8;
+      image_threads = std::min(image_threads, std::max<std::uint64_t>(1, usable_memory / peak_image_memory));
+    }
+    budget.image_threads = static_cast<unsigned int>(image_threads);
+  }
+  budget.describer_threads = std::max(1u, core_count / budget.image_threads);
+  return budget;
+}
+
+/// Admission control of the images described concurrently.
+/// Every image reserves its estimated peak working set before being decoded
+/// and releases it once described; an image only starts when its reservation
+/// fits in the memory budget. An image larger than the whole budget is
+/// admitted alone, so the extraction can always progress.
+class MemoryAdmission
+{
+public:
+  explicit MemoryAdmission(std::uint64_t budget)
+    : budget_(budget)
+  {}
+
+  MemoryAdmission(const MemoryAdmission &) = delete;
+  MemoryAdmission & operator=(const MemoryAdmission &) = delete;
+
+  void Acquire(std::uint64_t bytes)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!Fits(bytes))
+    {
+      const auto start = std::chrono::steady_clock::now();
+      released_.wait(lock, [&] { return Fits(bytes); });
+      wait_ += std::chrono::steady_clock::now() - start;
+      ++waiting_images_;
+    }
+    in_use_ += bytes;
+    peak_ = std::max(peak_, in_use_);
+  }
+
+  void Release(std::uint64_t bytes)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      in_use_ -= std::min(bytes, in_use_);
+    }
+    released_.notify_all();
+  }
+
+  std::uint64_t Budget() const { return budget_; }
+
+  std::uint64_t PeakUsage() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_;
+  }
+
+  /// Number of images that had to wait, and the cumulated waiting time
+  std::size_t WaitingImages() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return waiting_images_;
+  }
+
+  double WaitSeconds() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::chrono::duration<double>(wait_).count();
+  }
+
+private:
+  bool Fits(std::uint64_t bytes) const
+  {
+    return in_use_ == 0 || in_use_ + bytes <= budget_;
+  }
+
+  const std::uint64_t budget_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+  std::uint64_t in_use_ = 0, peak_ = 0;
+  std::size_t waiting_images_ = 0;
+  std::chrono::steady_clock::duration wait_{0};
+};
+
+} // namespace features
+} // namespace openMVG
+
+#endif // PRODUCTS_FEATURE_EXTRACTION_BUDGET_HPP
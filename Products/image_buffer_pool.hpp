@@ -0,0 +1,166 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_BUFFER_POOL_HPP
+#define PRODUCTS_IMAGE_BUFFER_POOL_HPP
+
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/image/image_io.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace openMVG {
+namespace image {
+
+/// Statistics of an ImageBufferPool
+struct ImageBufferPoolStats
+{
+  std::size_t requests = 0;           // images requested (Acquire, also called by Decode)
+  std::size_t allocations = 0;        // image buffers that had to be allocated
+  std::size_t decode_allocations = 0; // decode buffers that had to be (re)allocated
+  std::size_t peak_buffers = 0;       // buffers kept in the pool
+};
+
+/// Pool of image buffers that survive from one image to the next.
+///
+/// An image is given out by Acquire and given back by Release, possibly from
+/// another thread (decode -> describe). Acquire returns a pooled buffer of the
+/// same pixel count when there is one: resizing it to the requested size does
+/// not reallocate. With max_buffers = 0 the pool is disabled: every request
+/// allocates, and the counts measured that way are the reference.
+///
+/// Decode reads an image file into a pooled image. ReadImage(path, Image*)
+/// would decode into a temporary vector and copy it into a new image; here
+/// the file is decoded into a pooled decode buffer (its capacity is kept) and
+/// converted into the pooled image.
+template <typename T>
+class ImageBufferPool
+{
+public:
+  explicit ImageBufferPool(std::size_t max_buffers)
+    : max_buffers_(max_buffers)
+  {}
+
+  ImageBufferPool(const ImageBufferPool &) = delete;
+  ImageBufferPool & operator=(const ImageBufferPool &) = delete;
+
+  /// Image of width x height pixels (content undefined)
+  Image<T> Acquire(int width, int height)
+  {
+    const std::int64_t pixel_count = static_cast<std::int64_t>(width) * height;
+    Image<T> image;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.requests;
+      for (auto it = buffers_.begin(); it != buffers_.end(); ++it)
+      {
+        if (static_cast<std::int64_t>(it->size()) == pixel_count)
+        {
+          image = std::move(*it);
+          buffers_.erase(it);
+          break;
+        }
+      }
+      if (image.size() == 0)
+        ++stats_.allocations;
+    }
+    image.resize(width, height, false);
+    return image;
+  }
+
+  /// Decode an image file as gray levels (same conversion as ReadImage)
+  bool Decode(const std::string & filename, Image<T> & image)
+  {
+    static_assert(std::is_same<T, unsigned char>::value, "gray level images only");
+    std::vector<unsigned char> decode_buffer;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!decode_buffers_.empty())
+      {
+        decode_buffer = std::move(decode_buffers_.back());
+        decode_buffers_.pop_back();
+      }
+    }
+    const std::size_t capacity = decode_buffer.capacity();
+    int width = 0, height = 0, depth = 0;
+    const bool b_read = ReadImage(filename.c_str(), &decode_buffer, &width, &height, &depth) != 0
+      && (depth == 1 || depth == 3 || depth == 4);
+    if (decode_buffer.capacity() != capacity)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++stats_.decode_allocations;
+    }
+    if (b_read)
+    {
+      image = Acquire(width, height);
+      const std::size_t pixel_count = static_cast<std::size_t>(width) * height;
+      if (depth == 1)
+      {
+        std::memcpy(image.data(), decode_buffer.data(), pixel_count);
+      }
+      else
+      {
+        // RGB(A) to gray, as ConvertPixelType(Image<RGBColor>, Image<unsigned char>)
+        const unsigned char * pixel = decode_buffer.data();
+        unsigned char * gray = image.data();
+        for (std::size_t i = 0; i < pixel_count; ++i, pixel += depth)
+          gray[i] = static_cast<unsigned char>(0.3 * pixel[0] + 0.59 * pixel[1] + 0.11 * pixel[2]);
+      }
+    }
+    if (max_buffers_ > 0)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (decode_buffers_.size() < max_buffers_)
+        decode_buffers_.push_back(std::move(decode_buffer));
+    }
+    return b_read;
+  }
+
+  /// Give a buffer back to the pool (the oldest buffer is dropped when full)
+  void Release(Image<T> && image)
+  {
+    if (image.size() == 0 || max_buffers_ == 0)
+      return;
+    Image<T> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      buffers_.push_back(std::move(image));
+      if (buffers_.size() > max_buffers_)
+      {
+        dropped = std::move(buffers_.front());// freed outside of the lock
+        buffers_.pop_front();
+      }
+      if (buffers_.size() > stats_.peak_buffers)
+        stats_.peak_buffers = buffers_.size();
+    }
+  }
+
+  ImageBufferPoolStats Stats() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+private:
+  const std::size_t max_buffers_;
+  mutable std::mutex mutex_;
+  std::deque<Image<T>> buffers_;
+  std::vector<std::vector<unsigned char>> decode_buffers_;
+  ImageBufferPoolStats stats_;
+};
+
+} // namespace image
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_BUFFER_POOL_HPP
@@ -0,0 +1,284 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_DIRECTORY_ENUMERATOR_HPP
+#define PRODUCTS_IMAGE_DIRECTORY_ENUMERATOR_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace openMVG {
+namespace system {
+
+/// Natural order comparison: digit runs are compared by value
+/// (i.e "frame2.jpg" < "frame10.jpg").
+/// Strings that only differ by leading zeros are ordered by their number of
+/// zeros, then by plain character comparison, so the order is strict.
+inline bool NaturalLess(const std::string & a, const std::string & b)
+{
+  const auto is_digit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+  std::size_t i = 0, j = 0;
+  int zero_tie_break = 0;
+  while (i < a.size() && j < b.size())
+  {
+    if (is_digit(a[i]) && is_digit(b[j]))
+    {
+      std::size_t i_end = i, j_end = j;
+      while (i_end < a.size() && is_digit(a[i_end])) ++i_end;
+      while (j_end < b.size() && is_digit(b[j_end])) ++j_end;
+      std::size_t i_start = i, j_start = j;
+      while (i_start + 1 < i_end && a[i_start] == '0') ++i_start;
+      while (j_start + 1 < j_end && b[j_start] == '0') ++j_start;
+      if (i_end - i_start != j_end - j_start)
+        return (i_end - i_start) < (j_end - j_start);
+      const int cmp = a.compare(i_start, i_end - i_start, b, j_start, j_end - j_start);
+      if (cmp != 0)
+        return cmp < 0;
+      if (zero_tie_break == 0 && (i_end - i) != (j_end - j))
+        zero_tie_break = (i_end - i) < (j_end - j) ? -1 : 1;
+      i = i_end;
+      j = j_end;
+    }
+    else
+    {
+      if (a[i] != b[j])
+        return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[j]);
+      ++i;
+      ++j;
+    }
+  }
+  if ((a.size() - i) != (b.size() - j))
+    return (a.size() - i) < (b.size() - j);
+  if (zero_tie_break != 0)
+    return zero_tie_break < 0;
+  return a < b;
+}
+
+struct DirectoryEnumeratorOptions
+{
+  bool b_recursive = false;             // walk the sub-directories
+  std::vector<std::string> extensions;  // lower case allowlist without '.', empty: accept all files
+  std::size_t batch_size = 4096;        // number of files given to each callback call
+};
+
+/// Enumerate the files of sRootDir by batches of relative paths ('/' separated).
+/// Files are reported in natural order, the content of a sub-directory being
+/// reported after the files of its parent directory (depth first).
+/// Only the listing of the directories being walked is held in memory.
+/// Symbolic links are followed; a directory reached twice (symlink loop, or
+/// two links to the same directory) is only walked the first time.
+/// The enumeration stops as soon as the callback returns false.
+class DirectoryEnumerator
+{
+public:
+  using BatchCallback = std::function<bool(const std::vector<std::string> &)>;
+
+  DirectoryEnumerator
+  (
+    const std::string & sRootDir,
+    const DirectoryEnumeratorOptions & options
+  ): root_dir_(sRootDir), options_(options)
+  {
+    for (auto & ext : options_.extensions)
+    {
+      if (!ext.empty() && ext[0] == '.')
+        ext.erase(0, 1);
+      std::transform(ext.begin(), ext.end(), ext.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    }
+    options_.extensions.erase(
+      std::remove(options_.extensions.begin(), options_.extensions.end(), std::string()),
+      options_.extensions.end());
+    if (options_.batch_size == 0)
+      options_.batch_size = 1;
+  }
+
+  /// Return false if the root directory cannot be read
+  bool Enumerate(const BatchCallback & callback)
+  {
+    callback_ = &callback;
+    batch_.clear();
+    batch_.reserve(options_.batch_size);
+    b_stopped_ = false;
+    visited_directories_.clear();
+    const bool b_root_read = Walk("");
+    if (b_root_read && !b_stopped_ && !batch_.empty())
+      (*callback_)(batch_);
+    batch_.clear();
+    callback_ = nullptr;
+    return b_root_read;
+  }
+
+private:
+  bool AcceptExtension(const std::string & filename) const
+  {
+    if (options_.extensions.empty())
+      return true;
+    const std::string::size_type pos = filename.find_last_of('.');
+    if (pos == std::string::npos)
+      return false;
+    std::string ext = filename.substr(pos + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+      [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return std::find(options_.extensions.cbegin(), options_.extensions.cend(), ext)
+      != options_.extensions.cend();
+  }
+
+  /// (device, inode) of a directory, the same for all the paths leading to it
+  static bool DirectoryIdentity
+  (
+    const std::string & sDir,
+    std::pair<std::uint64_t, std::uint64_t> & identity
+  )
+  {
+#ifdef _WIN32
+    const HANDLE handle = ::CreateFileA(sDir.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+      nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+      return false;
+    BY_HANDLE_FILE_INFORMATION info;
+    const bool b_ok = ::GetFileInformationByHandle(handle, &info) != 0;
+    ::CloseHandle(handle);
+    if (!b_ok)
+      return false;
+    identity.first = info.dwVolumeSerialNumber;
+    identity.second = (static_cast<std::uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+#else
+    struct stat st;
+    if (::stat(sDir.c_str(), &st) != 0)
+      return false;
+    identity.first = static_cast<std::uint64_t>(st.st_dev);
+    identity.second = static_cast<std::uint64_t>(st.st_ino);
+#endif
+    return true;
+  }
+
+  /// List the files & sub-directories names of a directory
+  bool ReadDirectory
+  (
+    const std::string & sDir,
+    std::vector<std::string> & files,
+    std::vector<std::string> & folders
+  ) const
+  {
+#ifdef _WIN32
+    WIN32_FIND_DATAA find_data;
+    const HANDLE handle = ::FindFirstFileA((sDir + "\\*").c_str(), &find_data);
+    if (handle == INVALID_HANDLE_VALUE)
+      return false;
+    do
+    {
+      const std::string name = find_data.cFileName;
+      if (name == "." || name == "..")
+        continue;
+      if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        folders.push_back(name);
+      else if (AcceptExtension(name))
+        files.push_back(name);
+    } while (::FindNextFileA(handle, &find_data));
+    ::FindClose(handle);
+#else
+    DIR * dir = ::opendir(sDir.c_str());
+    if (!dir)
+      return false;
+    while (const struct dirent * entry = ::readdir(dir))
+    {
+      const std::string name = entry->d_name;
+      if (name == "." || name == "..")
+        continue;
+      bool b_folder = false, b_file = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+      if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK)
+      {
+        b_folder = entry->d_type == DT_DIR;
+        b_file = entry->d_type == DT_REG;
+      }
+      else
+#endif
+      {
+        // The file system does not report the entry type: ask for it
+        struct stat st;
+        if (::stat((sDir + '/' + name).c_str(), &st) == 0)
+        {
+          b_folder = S_ISDIR(st.st_mode);
+          b_file = S_ISREG(st.st_mode);
+        }
+      }
+      if (b_folder)
+        folders.push_back(name);
+      else if (b_file && AcceptExtension(name))
+        files.push_back(name);
+    }
+    ::closedir(dir);
+#endif
+    return true;
+  }
+
+  bool Walk(const std::string & sRelativeDir)
+  {
+    std::vector<std::string> files, folders;
+    const std::string sDir = sRelativeDir.empty() ? root_dir_ : root_dir_ + '/' + sRelativeDir;
+    std::pair<std::uint64_t, std::uint64_t> identity;
+    if (DirectoryIdentity(sDir, identity) && !visited_directories_.insert(identity).second)
+      return true; // already walked
+    if (!ReadDirectory(sDir, files, folders))
+      return false;
+
+    std::sort(files.begin(), files.end(), NaturalLess);
+    for (const auto & file : files)
+    {
+      batch_.push_back(sRelativeDir.empty() ? file : sRelativeDir + '/' + file);
+      if (batch_.size() == options_.batch_size)
+      {
+        b_stopped_ = !(*callback_)(batch_);
+        batch_.clear();
+        if (b_stopped_)
+          return true;
+      }
+    }
+    files = std::vector<std::string>(); // release the memory before going deeper
+
+    if (options_.b_recursive)
+    {
+      std::sort(folders.begin(), folders.end(), NaturalLess);
+      for (const auto & folder : folders)
+      {
+        Walk(sRelativeDir.empty() ? folder : sRelativeDir + '/' + folder);
+        if (b_stopped_)
+          return true;
+      }
+    }
+    return true;
+  }
+
+  std::string root_dir_;
+  DirectoryEnumeratorOptions options_;
+  const BatchCallback * callback_ = nullptr;
+  std::vector<std::string> batch_;
+  bool b_stopped_ = false;
+  std::set<std::pair<std::uint64_t, std::uint64_t>> visited_directories_;
+};
+
+} // namespace system
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_DIRECTORY_ENUMERATOR_HPP
@@ -0,0 +1,170 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_LISTING_CACHE_HPP
+#define PRODUCTS_IMAGE_LISTING_CACHE_HPP
+
+#include "image_listing_record.hpp"
+#include "mapped_file.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/unordered_map.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace openMVG {
+namespace sfm {
+
+/// File identity used to detect a changed file without reading it
+struct FileStamp
+{
+  std::uint64_t size = 0;
+  std::int64_t mtime = 0;
+
+  bool operator==(const FileStamp & rhs) const
+  {
+    return size == rhs.size && mtime == rhs.mtime;
+  }
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(size, mtime);
+  }
+};
+
+inline FileStamp GetFileStamp(const std::string & filename)
+{
+  FileStamp stamp;
+  stamp.size = static_cast<std::uint64_t>(stlplus::file_size(filename));
+  stamp.mtime = static_cast<std::int64_t>(stlplus::file_modified(filename));
+  return stamp;
+}
+
+/// Per-file listing metadata persisted next to sfm_data.json.
+/// Entries are keyed by the image path relative to the image root directory
+/// and are only valid for the same root directory & sensor database.
+class ImageListingCache
+{
+public:
+  ImageListingCache
+  (
+    const std::string & sRootPath,
+    const FileStamp & database_stamp
+  ): root_path_(sRootPath), database_stamp_(database_stamp)
+  {}
+
+  /// Load a previous cache. Return false (and keep the cache empty) if the
+  /// file is missing, unreadable or was built from other inputs.
+  bool Load(const std::string & filename)
+  {
+    entries_.clear();
+    std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!stream)
+      return false;
+    try
+    {
+      cereal::PortableBinaryInputArchive archive(stream);
+      std::uint32_t version = 0;
+      std::string root_path;
+      FileStamp database_stamp;
+      archive(version, root_path, database_stamp);
+      if (version != kVersion || root_path != root_path_ || !(database_stamp == database_stamp_))
+        return false;
+      archive(entries_);
+    }
+    catch (const cereal::Exception &)
+    {
+      entries_.clear();
+      return false;
+    }
+    return true;
+  }
+
+  /// Written to a temporary file renamed over filename, so an interrupted
+  /// listing never leaves a truncated cache for the next run
+  bool Save(const std::string & filename) const
+  {
+    const std::string temporary_filename = system::TemporaryFilename(filename);
+    {
+      std::ofstream stream(temporary_filename.c_str(), std::ios::out | std::ios::binary);
+      if (!stream)
+        return false;
+      {
+        cereal::PortableBinaryOutputArchive archive(stream);
+        const std::uint32_t version = kVersion;
+        archive(version, root_path_, database_stamp_, entries_);
+      }
+      if (!stream)
+      {
+        stream.close();
+        stlplus::file_delete(temporary_filename);
+        return false;
+      }
+    }
+    if (stlplus::file_rename(temporary_filename, filename)
+        || (stlplus::file_delete(filename) && stlplus::file_rename(temporary_filename, filename)))
+      return true;
+    stlplus::file_delete(temporary_filename);
+    return false;
+  }
+
+  /// Return the cached record of an image, or nullptr if the image is new or changed
+  const ImageListingRecord * Find
+  (
+    const std::string & sRelativePath,
+    const FileStamp & stamp
+  ) const
+  {
+    const auto it = entries_.find(sRelativePath);
+    if (it == entries_.cend() || !(it->second.stamp == stamp))
+      return nullptr;
+    return &it->second.record;
+  }
+
+  void Insert
+  (
+    const std::string & sRelativePath,
+    const FileStamp & stamp,
+    const ImageListingRecord & record
+  )
+  {
+    entries_[sRelativePath] = {stamp, record};
+  }
+
+  std::size_t size() const { return entries_.size(); }
+
+private:
+  struct Entry
+  {
+    FileStamp stamp;
+    ImageListingRecord record;
+
+    template <class Archive>
+    void serialize(Archive & ar)
+    {
+      ar(stamp, record);
+    }
+  };
+
+  // Bump when ImageListingRecord serialization changes
+  static const std::uint32_t kVersion = 4;
+
+  std::string root_path_;
+  FileStamp database_stamp_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_LISTING_CACHE_HPP
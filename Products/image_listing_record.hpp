@@ -0,0 +1,44 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_LISTING_RECORD_HPP
+#define PRODUCTS_IMAGE_LISTING_RECORD_HPP
+
+#include "image_quality.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace openMVG {
+namespace sfm {
+
+/// Image metadata gathered by the listing scan, before any view id is assigned
+struct ImageListingRecord
+{
+  bool b_readable = false; // the image header could be read
+  double width = -1.0, height = -1.0, focal = -1.0, ppx = -1.0, ppy = -1.0;
+  std::string camera_model; // EXIF "brand model", empty if unknown
+  std::string error_report; // messages for this image, reported in listing order
+  bool b_quality_scored = false; // the quality pre-screening was run on this image
+  image::ImageQualityScore quality;
+  bool b_perceptual_hash = false; // perceptual_hash was computed
+  std::uint64_t perceptual_hash = 0;
+  bool b_gps = false; // EXIF GPS position found
+  double latitude = 0.0, longitude = 0.0, altitude = 0.0;
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(b_readable, width, height, focal, ppx, ppy, camera_model, error_report,
+       b_quality_scored, quality, b_perceptual_hash, perceptual_hash,
+       b_gps, latitude, longitude, altitude);
+  }
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_LISTING_RECORD_HPP
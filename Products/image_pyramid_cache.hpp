@@ -0,0 +1,211 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_PYRAMID_CACHE_HPP
+#define PRODUCTS_IMAGE_PYRAMID_CACHE_HPP
+
+#include "openMVG/image/image_container.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace openMVG {
+namespace image {
+
+namespace pyramid_cache_internal {
+
+static const char kMagic[8] = {'O', 'M', 'V', 'G', 'P', 'Y', 'R', '\0'};
+static const std::uint32_t kVersion = 1;
+
+} // namespace pyramid_cache_internal
+
+/// Decoded grayscale image pyramid stored as one memory-mappable file per view:
+///   header | level table | level pixels (8 bit, row major)
+/// Level 0 is the full resolution image, each next level is 2x2 box
+/// downsampled. The size & modification time of the source image are stored
+/// to detect stale caches.
+class ImagePyramidCache
+{
+public:
+  struct Level
+  {
+    int width = 0;
+    int height = 0;
+    const unsigned char * pixels = nullptr;
+  };
+
+  /// Cache file of an image, sImagePath being relative to the image root
+  /// directory (sub-directories are mirrored in the cache directory)
+  static std::string Filename
+  (
+    const std::string & sCacheDir,
+    const std::string & sImagePath
+  )
+  {
+    return stlplus::create_filespec(sCacheDir, sImagePath + ".pyr");
+  }
+
+  static bool Write
+  (
+    const std::string & filename,
+    const Image<unsigned char> & image,
+    int level_count,
+    std::uint64_t source_size,
+    std::int64_t source_mtime
+  )
+  {
+    const std::string folder = stlplus::folder_part(filename);
+    if (!folder.empty() && !stlplus::folder_exists(folder) && !stlplus::folder_create(folder)
+        && !stlplus::folder_exists(folder)) // another thread may have created it
+      return false;
+
+    using namespace pyramid_cache_internal;
+    // Downsampled levels (level 0 is the input image itself)
+    std::vector<Image<unsigned char>> levels;
+    for (int i = 1; i < level_count; ++i)
+    {
+      const Image<unsigned char> & fine = levels.empty() ? image : levels.back();
+      if (fine.Width() < 2 || fine.Height() < 2)
+        break;
+      Image<unsigned char> coarse(fine.Width() / 2, fine.Height() / 2);
+      for (int y = 0; y < coarse.Height(); ++y)
+        for (int x = 0; x < coarse.Width(); ++x)
+          coarse(y, x) = static_cast<unsigned char>(
+            (fine(2 * y, 2 * x) + fine(2 * y, 2 * x + 1)
+             + fine(2 * y + 1, 2 * x) + fine(2 * y + 1, 2 * x + 1) + 2) / 4);
+      levels.push_back(std::move(coarse));
+    }
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.level_count = static_cast<std::uint32_t>(levels.size() + 1);
+    header.source_size = source_size;
+    header.source_mtime = source_mtime;
+
+    std::vector<LevelEntry> table(header.level_count);
+    std::uint64_t offset = sizeof(Header) + sizeof(LevelEntry) * table.size();
+    for (std::size_t i = 0; i < table.size(); ++i)
+    {
+      const Image<unsigned char> & level = (i == 0) ? image : levels[i - 1];
+      table[i].width = static_cast<std::uint32_t>(level.Width());
+      table[i].height = static_cast<std::uint32_t>(level.Height());
+      table[i].offset = offset;
+      offset += static_cast<std::uint64_t>(level.Width()) * level.Height();
+    }
+
+    // Write to a temporary file first, so a reader never maps a partial file
+    const std::string temporary_filename = filename + ".tmp";
+    {
+      std::ofstream stream(temporary_filename.c_str(), std::ios::out | std::ios::binary);
+      if (!stream)
+        return false;
+      stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+      stream.write(reinterpret_cast<const char *>(table.data()), sizeof(LevelEntry) * table.size());
+      for (std::size_t i = 0; i < table.size(); ++i)
+      {
+        const Image<unsigned char> & level = (i == 0) ? image : levels[i - 1];
+        stream.write(reinterpret_cast<const char *>(level.data()),
+          static_cast<std::streamsize>(level.Width()) * level.Height());
+      }
+      if (!stream)
+        return false;
+    }
+    return stlplus::file_rename(temporary_filename, filename)
+      || (stlplus::file_delete(filename) && stlplus::file_rename(temporary_filename, filename));
+  }
+
+  /// Map a cache file. Return false if it is missing, invalid or stale
+  /// (source_size/source_mtime not matching the current source image).
+  bool Open
+  (
+    const std::string & filename,
+    std::uint64_t source_size,
+    std::int64_t source_mtime
+  )
+  {
+    using namespace pyramid_cache_internal;
+    levels_.clear();
+    if (!file_.open(filename) || file_.size() < sizeof(Header))
+      return Close();
+    Header header;
+    std::memcpy(&header, file_.data(), sizeof(Header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion
+        || header.source_size != source_size || header.source_mtime != source_mtime
+        || file_.size() < sizeof(Header) + sizeof(LevelEntry) * header.level_count)
+      return Close();
+    const unsigned char * data = reinterpret_cast<const unsigned char *>(file_.data());
+    for (std::uint32_t i = 0; i < header.level_count; ++i)
+    {
+      LevelEntry entry;
+      std::memcpy(&entry, data + sizeof(Header) + sizeof(LevelEntry) * i, sizeof(LevelEntry));
+      if (entry.offset + static_cast<std::uint64_t>(entry.width) * entry.height > file_.size())
+        return Close();
+      Level level;
+      level.width = static_cast<int>(entry.width);
+      level.height = static_cast<int>(entry.height);
+      level.pixels = data + entry.offset;
+      levels_.push_back(level);
+    }
+    return !levels_.empty();
+  }
+
+  bool Close()
+  {
+    levels_.clear();
+    file_.close();
+    return false;
+  }
+
+  std::size_t LevelCount() const { return levels_.size(); }
+
+  /// Pixels of a level (valid while the cache is open)
+  const Level & GetLevel(std::size_t i) const { return levels_[i]; }
+
+  /// Copy a level into an image
+  bool ReadLevel(std::size_t i, Image<unsigned char> & image) const
+  {
+    if (i >= levels_.size())
+      return false;
+    image.resize(levels_[i].width, levels_[i].height, false);
+    std::memcpy(image.data(), levels_[i].pixels,
+      static_cast<std::size_t>(levels_[i].width) * levels_[i].height);
+    return true;
+  }
+
+private:
+  struct Header
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t level_count;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+  };
+
+  struct LevelEntry
+  {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t offset;
+  };
+
+  system::MappedFile file_;
+  std::vector<Level> levels_;
+};
+
+} // namespace image
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_PYRAMID_CACHE_HPP
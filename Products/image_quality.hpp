@@ -0,0 +1,110 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_QUALITY_HPP
+#define PRODUCTS_IMAGE_QUALITY_HPP
+
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/image/image_io.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace openMVG {
+namespace image {
+
+/// Cheap quality scores of an image, computed on a decimated grayscale copy
+struct ImageQualityScore
+{
+  double sharpness = 0.0;      // variance of the Laplacian (low: blurred)
+  double clipped_ratio = 0.0;  // ratio of under (<= 8) or over (>= 247) exposed pixels
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(sharpness, clipped_ratio);
+  }
+};
+
+/// Box filter decimation so that the largest image side is <= max_size
+inline void DecimateImage
+(
+  const Image<unsigned char> & image,
+  int max_size,
+  Image<unsigned char> & decimated
+)
+{
+  const int factor = std::max(1,
+    (std::max(image.Width(), image.Height()) + max_size - 1) / std::max(1, max_size));
+  const int w = image.Width() / factor, h = image.Height() / factor;
+  decimated.resize(w, h);
+  for (int y = 0; y < h; ++y)
+  {
+    for (int x = 0; x < w; ++x)
+    {
+      std::uint32_t sum = 0;
+      for (int j = 0; j < factor; ++j)
+        for (int i = 0; i < factor; ++i)
+          sum += image(y * factor + j, x * factor + i);
+      decimated(y, x) = static_cast<unsigned char>(sum / (factor * factor));
+    }
+  }
+}
+
+/// Measure the sharpness & exposure of a grayscale image
+inline ImageQualityScore ScoreImageQuality(const Image<unsigned char> & image)
+{
+  ImageQualityScore score;
+  const int w = image.Width(), h = image.Height();
+  if (w < 3 || h < 3)
+    return score;
+
+  std::size_t clipped = 0;
+  for (int y = 0; y < h; ++y)
+    for (int x = 0; x < w; ++x)
+      clipped += (image(y, x) <= 8 || image(y, x) >= 247) ? 1 : 0;
+  score.clipped_ratio = static_cast<double>(clipped) / (static_cast<double>(w) * h);
+
+  // 4-neighbour Laplacian variance
+  double sum = 0.0, sum_sq = 0.0;
+  for (int y = 1; y < h - 1; ++y)
+  {
+    for (int x = 1; x < w - 1; ++x)
+    {
+      const double laplacian =
+        static_cast<double>(image(y - 1, x)) + image(y + 1, x)
+        + image(y, x - 1) + image(y, x + 1) - 4.0 * image(y, x);
+      sum += laplacian;
+      sum_sq += laplacian * laplacian;
+    }
+  }
+  const double n = static_cast<double>(w - 2) * (h - 2);
+  const double mean = sum / n;
+  score.sharpness = sum_sq / n - mean * mean;
+  return score;
+}
+
+/// Decode an image in grayscale and decimate it.
+/// Return false if the image cannot be decoded.
+inline bool ReadDecimatedImage
+(
+  const std::string & sImageFilename,
+  int max_size,
+  Image<unsigned char> & decimated
+)
+{
+  Image<unsigned char> image;
+  if (!ReadImage(sImageFilename.c_str(), &image))
+    return false;
+  DecimateImage(image, max_size, decimated);
+  return true;
+}
+
+} // namespace image
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_QUALITY_HPP
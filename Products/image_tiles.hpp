@@ -0,0 +1,267 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_IMAGE_TILES_HPP
+#define PRODUCTS_IMAGE_TILES_HPP
+
+#include "openMVG/features/feature.hpp"
+#include "openMVG/features/image_describer.hpp"
+#include "openMVG/features/regions.hpp"
+#include "openMVG/image/image_container.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+
+namespace openMVG {
+namespace image {
+
+/// Axis aligned rectangle of an image, in pixels (empty if width or height is 0)
+struct ImageRect
+{
+  int x = 0, y = 0;
+  int width = 0, height = 0;
+
+  bool empty() const { return width <= 0 || height <= 0; }
+  long long area() const { return empty() ? 0 : static_cast<long long>(width) * height; }
+
+  bool contains(float px, float py) const
+  {
+    return px >= x && py >= y && px < x + width && py < y + height;
+  }
+};
+
+/// Tile of a tiled extraction: the core rectangles partition the image, the
+/// padded rectangle adds the border given to the describer around the core.
+struct ImageTile
+{
+  ImageRect core, padded;
+};
+
+/// Split a width x height image in tile_size x tile_size cores padded by
+/// border pixels (clipped to the image)
+inline std::vector<ImageTile> ComputeImageTiles
+(
+  int width,
+  int height,
+  int tile_size,
+  int border
+)
+{
+  std::vector<ImageTile> tiles;
+  for (int y = 0; y < height; y += tile_size)
+  {
+    for (int x = 0; x < width; x += tile_size)
+    {
+      ImageTile tile;
+      tile.core.x = x;
+      tile.core.y = y;
+      tile.core.width = std::min(tile_size, width - x);
+      tile.core.height = std::min(tile_size, height - y);
+      tile.padded.x = std::max(0, x - border);
+      tile.padded.y = std::max(0, y - border);
+      tile.padded.width = std::min(width, x + tile.core.width + border) - tile.padded.x;
+      tile.padded.height = std::min(height, y + tile.core.height + border) - tile.padded.y;
+      tiles.push_back(tile);
+    }
+  }
+  return tiles;
+}
+
+/// True if the rectangle of the mask has at least one unmasked (non zero) pixel
+inline bool HasUnmaskedPixel
+(
+  const Image<unsigned char> & mask,
+  const ImageRect & rect
+)
+{
+  for (int y = rect.y; y < rect.y + rect.height; ++y)
+  {
+    const unsigned char * row = mask.data() + static_cast<size_t>(y) * mask.Width();
+    if (std::any_of(row + rect.x, row + rect.x + rect.width, [](unsigned char value) { return value != 0; }))
+      return true;
+  }
+  return false;
+}
+
+/// Part of the image worth describing according to its mask.
+/// The mask is split in tile_size x tile_size tiles; the tiles without any
+/// unmasked (non zero) pixel are skipped and the result is the bounding box
+/// of the remaining tiles, grown by margin pixels so the scale space near the
+/// unmasked border still sees the same neighbourhood.
+/// An empty rectangle is returned for a fully masked image.
+inline ImageRect ComputeMaskedCrop
+(
+  const Image<unsigned char> & mask,
+  int tile_size,
+  int margin
+)
+{
+  const int tile_cols = (mask.Width() + tile_size - 1) / tile_size;
+  const int tile_rows = (mask.Height() + tile_size - 1) / tile_size;
+  int min_col = tile_cols, max_col = -1, min_row = tile_rows, max_row = -1;
+  for (int tile_row = 0; tile_row < tile_rows; ++tile_row)
+  {
+    const int y_end = std::min(mask.Height(), (tile_row + 1) * tile_size);
+    for (int tile_col = 0; tile_col < tile_cols; ++tile_col)
+    {
+      // Tiles inside the current bounding box cannot grow it
+      if (tile_row > min_row && tile_row < max_row && tile_col > min_col && tile_col < max_col)
+        continue;
+      const int x_begin = tile_col * tile_size;
+      const int x_end = std::min(mask.Width(), x_begin + tile_size);
+      bool bActive = false;
+      for (int y = tile_row * tile_size; y < y_end && !bActive; ++y)
+      {
+        const unsigned char * row = mask.data() + static_cast<size_t>(y) * mask.Width();
+        bActive = std::any_of(row + x_begin, row + x_end, [](unsigned char value) { return value != 0; });
+      }
+      if (bActive)
+      {
+        min_col = std::min(min_col, tile_col);
+        max_col = std::max(max_col, tile_col);
+        min_row = std::min(min_row, tile_row);
+        max_row = std::max(max_row, tile_row);
+      }
+    }
+  }
+
+  ImageRect crop;
+  if (max_col < 0)
+    return crop;
+  crop.x = std::max(0, min_col * tile_size - margin);
+  crop.y = std::max(0, min_row * tile_size - margin);
+  crop.width = std::min(mask.Width(), (max_col + 1) * tile_size + margin) - crop.x;
+  crop.height = std::min(mask.Height(), (max_row + 1) * tile_size + margin) - crop.y;
+  return crop;
+}
+
+/// Copy of a rectangle of an image
+template <typename T>
+Image<T> CropImage
+(
+  const Image<T> & image,
+  const ImageRect & rect
+)
+{
+  return Image<T>(typename Image<T>::Base(
+    image.GetMat().block(rect.y, rect.x, rect.height, rect.width)));
+}
+
+/// Crop into an existing image: its buffer is reused when the crop has the
+/// same pixel count (per thread buffers kept from one image to the next)
+template <typename T>
+void CropImage
+(
+  const Image<T> & image,
+  const ImageRect & rect,
+  Image<T> & crop
+)
+{
+  crop.resize(rect.width, rect.height, false);
+  crop.GetMat() = image.GetMat().block(rect.y, rect.x, rect.height, rect.width);
+}
+
+} // namespace image
+
+namespace features {
+
+/// Move the keypoints of regions computed on a crop back to the full image
+/// frame. Return false if the regions do not store SIOPointFeature keypoints.
+inline bool OffsetRegions
+(
+  Regions * regions,
+  float dx,
+  float dy
+)
+{
+  auto * sio_regions = dynamic_cast<Feat_Regions<SIOPointFeature> *>(regions);
+  if (!sio_regions)
+    return false;
+  for (SIOPointFeature & feature : sio_regions->Features())
+  {
+    feature.x() += dx;
+    feature.y() += dy;
+  }
+  return true;
+}
+
+/// Tiled extraction, for images whose scale space does not fit in memory.
+/// The describer runs on overlapping tiles (core + border, the border being
+/// the context needed by the coarsest octaves), tiles in parallel; a
+/// keypoint is only kept by the tile whose core contains it, which removes
+/// the duplicates detected in the overlap of two tiles. Fully masked tiles
+/// are skipped. The peak memory depends on the tile size and on the number
+/// of tiles described concurrently, not on the image size.
+/// Return nullptr if the describer regions cannot be merged (no
+/// SIOPointFeature keypoints).
+inline std::unique_ptr<Regions> DescribeTiled
+(
+  Image_describer & image_describer,
+  const image::Image<unsigned char> & image,
+  const image::Image<unsigned char> * mask,
+  int tile_size,
+  int border,
+  int thread_count
+)
+{
+  std::unique_ptr<Regions> merged_regions = image_describer.Allocate();
+  if (!OffsetRegions(merged_regions.get(), 0.f, 0.f))
+    return nullptr;
+
+  const std::vector<image::ImageTile> tiles =
+    image::ComputeImageTiles(image.Width(), image.Height(), tile_size, border);
+  std::vector<std::unique_ptr<Regions>> tile_regions(tiles.size());
+
+#ifdef OPENMVG_USE_OPENMP
+  #pragma omp parallel for schedule(dynamic) num_threads(std::max(1, thread_count))
+#endif
+  for (int i = 0; i < static_cast<int>(tiles.size()); ++i)
+  {
+#ifdef OPENMVG_USE_OPENMP
+    omp_set_num_threads(1); // the cores are already shared by the tiles
+#endif
+    const image::ImageTile & tile = tiles[i];
+    if (mask && !image::HasUnmaskedPixel(*mask, tile.core))
+      continue;
+    const image::Image<unsigned char> tile_image = image::CropImage(image, tile.padded);
+    if (mask)
+    {
+      const image::Image<unsigned char> tile_mask = image::CropImage(*mask, tile.padded);
+      tile_regions[i] = image_describer.Describe(tile_image, &tile_mask);
+    }
+    else
+    {
+      tile_regions[i] = image_describer.Describe(tile_image, nullptr);
+    }
+    if (tile_regions[i])
+      OffsetRegions(tile_regions[i].get(), static_cast<float>(tile.padded.x), static_cast<float>(tile.padded.y));
+  }
+
+  // Merge in tile order (deterministic output)
+  for (size_t i = 0; i < tiles.size(); ++i)
+  {
+    if (!tile_regions[i])
+      continue;
+    for (size_t j = 0; j < tile_regions[i]->RegionCount(); ++j)
+    {
+      const Vec2 position = tile_regions[i]->GetRegionPosition(j);
+      if (tiles[i].core.contains(position(0), position(1)))
+        tile_regions[i]->CopyRegion(j, merged_regions.get());
+    }
+    tile_regions[i].reset();
+  }
+  return merged_regions;
+}
+
+} // namespace features
+} // namespace openMVG
+
+#endif // PRODUCTS_IMAGE_TILES_HPP
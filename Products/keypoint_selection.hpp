@@ -0,0 +1,178 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_KEYPOINT_SELECTION_HPP
+#define PRODUCTS_KEYPOINT_SELECTION_HPP
+
+#include "openMVG/features/feature.hpp"
+#include "openMVG/features/regions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace openMVG {
+namespace features {
+
+/// Indices of at most max_count keypoints spread uniformly over a
+/// width x height image (grid bucketing).
+///
+/// The image is split in about max_count / kKeypointsPerCell cells of the
+/// image aspect ratio. Every cell gets the same quota, the quota that sparse
+/// cells cannot use is shared by the others (water filling), and each cell
+/// keeps its best scores (nth_element). The cost is linear in the number of
+/// keypoints, plus a sort of the cell sizes and of the kept indices.
+/// The indices are returned in increasing order.
+inline std::vector<std::size_t> SelectGridKeypoints
+(
+  const std::vector<PointFeature> & positions,
+  const std::vector<float> & scores,
+  std::size_t max_count,
+  int width,
+  int height
+)
+{
+  const std::size_t count = positions.size();
+  std::vector<std::size_t> kept(count);
+  std::iota(kept.begin(), kept.end(), std::size_t(0));
+  if (count <= max_count || width <= 0 || height <= 0)
+    return kept;
+  if (max_count == 0)
+    return {};
+
+  const double kKeypointsPerCell = 4.0;
+  const double cell_count = std::max(1.0, static_cast<double>(max_count) / kKeypointsPerCell);
+  const double cell_size = std::sqrt(static_cast<double>(width) * height / cell_count);
+  const int cols = std::max(1, static_cast<int>(std::ceil(width / cell_size)));
+  const int rows = std::max(1, static_cast<int>(std::ceil(height / cell_size)));
+
+  // Bucket the keypoints (counting sort by cell)
+  std::vector<std::size_t> cell_begin(static_cast<std::size_t>(cols) * rows + 1, 0);
+  std::vector<std::size_t> cell_of(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const int col = std::min(cols - 1, std::max(0, static_cast<int>(positions[i].x() * cols / width)));
+    const int row = std::min(rows - 1, std::max(0, static_cast<int>(positions[i].y() * rows / height)));
+    cell_of[i] = static_cast<std::size_t>(row) * cols + col;
+    ++cell_begin[cell_of[i] + 1];
+  }
+  std::partial_sum(cell_begin.begin(), cell_begin.end(), cell_begin.begin());
+  std::vector<std::size_t> bucketed(count);
+  {
+    std::vector<std::size_t> cursor(cell_begin.begin(), cell_begin.end() - 1);
+    for (std::size_t i = 0; i < count; ++i)
+      bucketed[cursor[cell_of[i]]++] = i;
+  }
+
+  // Water filling of the quota: the cells are visited from the sparsest
+  std::vector<std::size_t> cells;
+  for (std::size_t c = 0; c + 1 < cell_begin.size(); ++c)
+    if (cell_begin[c + 1] > cell_begin[c])
+      cells.push_back(c);
+  std::sort(cells.begin(), cells.end(), [&](std::size_t a, std::size_t b)
+  {
+    return cell_begin[a + 1] - cell_begin[a] < cell_begin[b + 1] - cell_begin[b];
+  });
+  std::vector<std::size_t> quota(cell_begin.size() - 1, 0);
+  std::size_t remaining = max_count;
+  for (std::size_t k = 0; k < cells.size(); ++k)
+  {
+    const std::size_t cell = cells[k];
+    const std::size_t share = remaining / (cells.size() - k);
+    quota[cell] = std::min(share, cell_begin[cell + 1] - cell_begin[cell]);
+    remaining -= quota[cell];
+  }
+
+  // Best scores of each cell
+  kept.clear();
+  for (const std::size_t cell : cells)
+  {
+    const auto first = bucketed.begin() + cell_begin[cell];
+    const auto last = bucketed.begin() + cell_begin[cell + 1];
+    const auto middle = first + quota[cell];
+    if (middle != last)
+    {
+      std::nth_element(first, middle, last, [&](std::size_t a, std::size_t b)
+      {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+      });
+    }
+    kept.insert(kept.end(), first, middle);
+  }
+  std::sort(kept.begin(), kept.end());
+  return kept;
+}
+
+/// Keep at most max_count regions, spread uniformly over the image.
+/// Fallback for the describers that cannot select their keypoints before the
+/// description (see SIFT_Anatomy_SIMD_Image_describer::SetKeypointSelection):
+/// the regions do not store the detector response, so the keypoint scale
+/// ranks the keypoints of a cell (the coarse keypoints are the most
+/// repeatable ones). Return nullptr when nothing has to be removed.
+inline std::unique_ptr<Regions> SelectUniformRegions
+(
+  const Regions & regions,
+  std::size_t max_count,
+  int width,
+  int height
+)
+{
+  const std::size_t count = regions.RegionCount();
+  if (count <= max_count)
+    return nullptr;
+
+  std::vector<PointFeature> positions;
+  positions.reserve(count);
+  std::vector<float> scores(count, 0.f);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vec2 position = regions.GetRegionPosition(i);
+    positions.emplace_back(static_cast<float>(position(0)), static_cast<float>(position(1)));
+  }
+  if (auto * sio_regions = dynamic_cast<const Feat_Regions<SIOPointFeature> *>(&regions))
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      scores[i] = sio_regions->Features()[i].scale();
+  }
+
+  std::unique_ptr<Regions> selected(regions.EmptyClone());
+  for (const std::size_t i : SelectGridKeypoints(positions, scores, max_count, width, height))
+    regions.CopyRegion(i, selected.get());
+  return selected;
+}
+
+/// Regions reordered by decreasing score (the keypoint scale, see
+/// SelectUniformRegions), so that the first N records are the N best ones
+/// and a preemptive reader can stop after them. Return nullptr when the
+/// regions are not SIOPointFeature regions or are already sorted.
+inline std::unique_ptr<Regions> SortRegionsByScore(const Regions & regions)
+{
+  auto * sio_regions = dynamic_cast<const Feat_Regions<SIOPointFeature> *>(&regions);
+  if (!sio_regions)
+    return nullptr;
+  const std::vector<SIOPointFeature> & features = sio_regions->Features();
+  std::vector<std::size_t> order(features.size());
+  std::iota(order.begin(), order.end(), std::size_t(0));
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+  {
+    return features[a].scale() > features[b].scale();
+  });
+  if (std::is_sorted(order.begin(), order.end()))
+    return nullptr;
+
+  std::unique_ptr<Regions> sorted(regions.EmptyClone());
+  for (const std::size_t i : order)
+    regions.CopyRegion(i, sorted.get());
+  return sorted;
+}
+
+} // namespace features
+} // namespace openMVG
+
+#endif // PRODUCTS_KEYPOINT_SELECTION_HPP
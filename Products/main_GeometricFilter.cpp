@@ -32,6 +32,11 @@
 #include "openMVG/stl/stl.hpp"
 #include "openMVG/system/timer.hpp"
 
+#include "python_hook.hpp"
+#include "regions_pack.hpp"
+#include "sfm_data_indexed_io.hpp"
+#include "view_id_pairs.hpp"
+
 #include "third_party/cmdLine/cmdLine.h"
 #include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
 
@@ -39,18 +44,16 @@
 #include <iostream>
 #include <locale>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
-//python Embed
-#include<pybind11/pybind11.h>
-#include<pybind11/embed.h>
-
-namespace py = pybind11;
 using namespace openMVG;
 using namespace openMVG::matching;
 using namespace openMVG::robust;
 using namespace openMVG::sfm;
 using namespace openMVG::matching_image_collection;
+using namespace openMVG::system;
 
 enum EGeometricModel
 {
@@ -69,13 +72,6 @@ enum EGeometricModel
 /// - Export computed data
 int main(int argc, char** argv)
 {
-    py::scoped_interpreter guard{};
-
-    auto main_GeometricFilter_Module = py::module_::import("main_GeometricFilter");
- auto print_usage = main_GeometricFilter_Module.attr("print_usage");
- auto print_usage_info = main_GeometricFilter_Module.attr("print_usage_info");
- auto get_geometric_model = main_GeometricFilter_Module.attr("get_geometric_model");
- auto create_and_export_graph = main_GeometricFilter_Module.attr("create_and_export_graph");
     CmdLine cmd;
 
     // The scene
@@ -94,6 +90,7 @@ int main(int argc, char** argv)
     bool         bGuided_matching = false;
     int          imax_iteration = 2048;
     unsigned int ui_max_cache_size = 0;
+    std::string  sPythonHook;
 
     //required
     cmd.add(make_option('i', sSfM_Data_Filename, "input_file"));
@@ -107,6 +104,7 @@ int main(int argc, char** argv)
     cmd.add(make_option('r', bGuided_matching, "guided_matching"));
     cmd.add(make_option('I', imax_iteration, "max_iteration"));
     cmd.add(make_option('c', ui_max_cache_size, "cache_size"));
+    cmd.add(make_option('y', sPythonHook, "python_hook"));
 
     try
     {
@@ -116,34 +114,45 @@ int main(int argc, char** argv)
     }
     catch (const std::string& s)
     {
-        std::string usage = "Usage: " + std::string(argv[0]) + "\n";
-        print_usage(usage);
+        OPENMVG_LOG_INFO << "Usage: " << argv[0] << '\n'
+            << "[-i|--input_file]       A SfM_Data file\n"
+            << "[-m|--matches]          (Input) matches filename\n"
+            << "[-o|--output_file]      (Output) filtered matches filename\n"
+            << "\n[Optional]\n"
+            << "[-p|--input_pairs]      (Input) pairs filename\n"
+            << "[-s|--output_pairs]     (Output) filtered pairs filename\n"
+            << "[-f|--force]            Force to recompute data\n"
+            << "[-g|--geometric_model]\n"
+            << "  (pairwise correspondences filtering thanks to robust model estimation):\n"
+            << "   f: (default) fundamental matrix,\n"
+            << "   e: essential matrix,\n"
+            << "   h: homography matrix.\n"
+            << "   a: essential matrix with an angular parametrization,\n"
+            << "   u: upright essential matrix with an angular parametrization,\n"
+            << "   o: orthographic essential matrix.\n"
+            << "[-r|--guided_matching]  Use the found model to improve the pairwise correspondences.\n"
+            << "[-c|--cache_size]\n"
+            << "  Use a regions cache (only cache_size regions will be stored in memory)\n"
+            << "  If not used, all regions will be load in memory.\n"
+            << "[-y|--python_hook]      Optional Python module, its\n"
+            << "  create_and_export_graph(view_ids, pairs, matches_directory) is called at the end.";
         OPENMVG_LOG_INFO << s;
         return EXIT_FAILURE;
     }
 
-    std::string program_name = argv[0];
-    std::string input_file = "example_input.txt";
-    std::string matches_file = "example_matches.txt";
-    std::string output_file = "example_output.txt";
-    std::string input_pairs = "example_pairs.txt";
-    std::string output_pairs = "example_filtered_pairs.txt";
-    bool force = false;
-    std::string geometric_model = "f";
-    bool guided_matching = false;
-    std::string cache_size = "unlimited"
-
-    py::str py_program_name = py::cast(program_name);
-    py::str py_input_file = py::cast(input_file);
-    py::str py_matches_file = py::cast(matches_file);
-    py::str py_output_file = py::cast(output_file);
-    py::str py_input_pairs = py::cast(input_pairs);
-    py::str py_output_pairs = py::cast(output_pairs);
-    py::str py_geometric_model = py::cast(geometric_model);
-    py::str py_cache_size = py::cast(cache_size);
-    print_usage_info(py_program_name, py_input_file, py_matches_file, py_output_file,
-        py_input_pairs, py_output_pairs, force, py_geometric_model,
-        guided_matching, py_cache_size);
+    OPENMVG_LOG_INFO << " You called : " << "\n"
+        << argv[0] << "\n"
+        << "--input_file:           " << sSfM_Data_Filename << "\n"
+        << "--matches:              " << sPutativeMatchesFilename << "\n"
+        << "--output_file:          " << sFilteredMatchesFilename << "\n"
+        << "Optional parameters: " << "\n"
+        << "--input_pairs           " << sInputPairsFilename << "\n"
+        << "--output_pairs          " << sOutputPairsFilename << "\n"
+        << "--force                 " << (bForce ? "true" : "false") << "\n"
+        << "--geometric_model       " << sGeometricModel << "\n"
+        << "--guided_matching       " << bGuided_matching << "\n"
+        << "--cache_size            " << ((ui_max_cache_size == 0) ? "unlimited" : std::to_string(ui_max_cache_size)) << "\n"
+        << "--python_hook           " << sPythonHook;
 
     if (sFilteredMatchesFilename.empty())
     {
@@ -164,46 +173,83 @@ int main(int argc, char** argv)
     const std::string sMatchesDirectory = stlplus::folder_part(sPutativeMatchesFilename);
 
     EGeometricModel eGeometricModelToCompute = FUNDAMENTAL_MATRIX;
-    enum GeometricModel {
-        FUNDAMENTAL_MATRIX,
-        ESSENTIAL_MATRIX,
-        HOMOGRAPHY_MATRIX,
-        ESSENTIAL_MATRIX_ANGULAR,
-        ESSENTIAL_MATRIX_UPRIGHT,
-        ESSENTIAL_MATRIX_ORTHO
-    };
-    char model_char = std::tolower(sGeometricModel[0]);
-
-    try {
-        
-        GeometricModel eGeometricModelToCompute = py::cast<GeometricModel>(get_geometric_model(model_char));
-
-        std::cout << "Selected geometric model: " << eGeometricModelToCompute << std::endl;
-    }
-    catch (const py::cast_error& e) {
-     
-        OPENMVG_LOG_ERROR << "Failed to cast Python return value: " << e.what();
-        return EXIT_FAILURE;
-    }
-    catch (const py::error_already_set& e) {
-      
-        OPENMVG_LOG_ERROR << "Python exception occurred: " << py::print_exception();
+    switch (std::tolower(sGeometricModel[0], std::locale()))
+    {
+    case 'f':
+        eGeometricModelToCompute = FUNDAMENTAL_MATRIX;
+        break;
+    case 'e':
+        eGeometricModelToCompute = ESSENTIAL_MATRIX;
+        break;
+    case 'h':
+        eGeometricModelToCompute = HOMOGRAPHY_MATRIX;
+        break;
+    case 'a':
+        eGeometricModelToCompute = ESSENTIAL_MATRIX_ANGULAR;
+        break;
+    case 'u':
+        eGeometricModelToCompute = ESSENTIAL_MATRIX_UPRIGHT;
+        break;
+    case 'o':
+        eGeometricModelToCompute = ESSENTIAL_MATRIX_ORTHO;
+        break;
+    default:
+        OPENMVG_LOG_ERROR << "Unknown geometric model";
         return EXIT_FAILURE;
     }
 
     // -----------------------------
-    // - Load SfM_Data Views & intrinsics data
     // a. Load putative descriptor matches
     // [a.1] Filter matches with input pairs
+    // - Load SfM_Data Views & intrinsics data (only the matched views if possible)
     // b. Geometric filtering of putative matches
     // + Export some statistics
     // -----------------------------
 
+    // The view ids may have gaps (incremental listing): N is max id + 1
+    std::vector<IndexT> view_ids;
+    if (!GetSfMDataViewIds(sSfM_Data_Filename, view_ids))
+    {
+        OPENMVG_LOG_ERROR << "The input SfM_Data file \"" << sSfM_Data_Filename << "\" cannot be read.";
+        return EXIT_FAILURE;
+    }
+    const std::size_t view_count = ViewIdBound(view_ids);
+
+    PairWiseMatches map_PutativeMatches;
+    //---------------------------------------
+    // A. Load initial matches
+    //---------------------------------------
+    if (!Load(map_PutativeMatches, sPutativeMatchesFilename))
+    {
+        OPENMVG_LOG_ERROR << "Failed to load the initial matches file.";
+        return EXIT_FAILURE;
+    }
+
+    if (!sInputPairsFilename.empty())
+    {
+        // Load input pairs
+        OPENMVG_LOG_INFO << "Loading input pairs ...";
+        Pair_Set input_pairs;
+        loadPairs(view_count, sInputPairsFilename, input_pairs);
+
+        // Filter matches with the given pairs
+        OPENMVG_LOG_INFO << "Filtering matches with the given pairs.";
+        map_PutativeMatches = getPairs(map_PutativeMatches, input_pairs);
+    }
+
     //---------------------------------------
     // Read SfM Scene (image view & intrinsics data)
+    // With an indexed sfm_data (.ibin) only the views of the putative pairs
+    // (and their intrinsics) are read, so are their regions.
     //---------------------------------------
+    std::set<IndexT> matched_view_ids;
+    for (const auto & pairwise_matches : map_PutativeMatches)
+    {
+        matched_view_ids.insert(pairwise_matches.first.first);
+        matched_view_ids.insert(pairwise_matches.first.second);
+    }
     SfM_Data sfm_data;
-    if (!Load(sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS | INTRINSICS)))
+    if (!LoadSfMData(sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS | INTRINSICS), &matched_view_ids))
     {
         OPENMVG_LOG_ERROR << "The input SfM_Data file \"" << sSfM_Data_Filename << "\" cannot be read.";
         return EXIT_FAILURE;
@@ -231,7 +277,19 @@ int main(int argc, char** argv)
 
     // Load the corresponding view regions
     std::shared_ptr<Regions_Provider> regions_provider;
-    if (ui_max_cache_size == 0)
+    const bool bPackedRegions = stlplus::file_exists(features::RegionsPackFilename(sMatchesDirectory));
+    if (bPackedRegions && ui_max_cache_size > 0)
+    {
+        OPENMVG_LOG_ERROR << "The regions of " << sMatchesDirectory << " are in a container (ComputeFeatures -k):"
+          << " it is mapped and paged on demand, the regions cache (-c) does not apply to it.";
+        return EXIT_FAILURE;
+    }
+    if (bPackedRegions)
+    {
+        // Regions container (ComputeFeatures -k): one mapped file instead of a .feat/.desc pair per view
+        regions_provider = std::make_shared<Packed_Regions_Provider>();
+    }
+    else if (ui_max_cache_size == 0)
     {
         // Default regions provider (load & store all regions in memory)
         regions_provider = std::make_shared<Regions_Provider>();
@@ -251,28 +309,6 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
-    PairWiseMatches map_PutativeMatches;
-    //---------------------------------------
-    // A. Load initial matches
-    //---------------------------------------
-    if (!Load(map_PutativeMatches, sPutativeMatchesFilename))
-    {
-        OPENMVG_LOG_ERROR << "Failed to load the initial matches file.";
-        return EXIT_FAILURE;
-    }
-
-    if (!sInputPairsFilename.empty())
-    {
-        // Load input pairs
-        OPENMVG_LOG_INFO << "Loading input pairs ...";
-        Pair_Set input_pairs;
-        loadPairs(sfm_data.GetViews().size(), sInputPairsFilename, input_pairs);
-
-        // Filter matches with the given pairs
-        OPENMVG_LOG_INFO << "Filtering matches with the given pairs.";
-        map_PutativeMatches = getPairs(map_PutativeMatches, input_pairs);
-    }
-
     //---------------------------------------
     // b. Geometric filtering of putative matches
     //    - AContrario Estimation of the desired geometric model
@@ -382,14 +418,14 @@ int main(int argc, char** argv)
         }
 
         // -- export Geometric View Graph statistics
-        graph::getGraphStatistics(sfm_data.GetViews().size(), getPairs(map_GeometricMatches));
+        graph::getGraphStatistics(view_count, getPairs(map_GeometricMatches));
 
         OPENMVG_LOG_INFO << "Task done in (s): " << timer.elapsed();
 
         //-- export Adjacency matrix
         OPENMVG_LOG_INFO << "\n Export Adjacency Matrix of the pairwise's geometric matches";
 
-        PairWiseMatchingToAdjacencyMatrixSVG(sfm_data.GetViews().size(),
+        PairWiseMatchingToAdjacencyMatrixSVG(view_count,
             map_GeometricMatches,
             stlplus::create_filespec(sMatchesDirectory, "GeometricAdjacencyMatrix", "svg"));
 
@@ -403,19 +439,15 @@ int main(int argc, char** argv)
             graph::exportToGraphvizData(
                 stlplus::create_filespec(sMatchesDirectory, "geometric_matches"),
                 putativeGraph);
+
+            // Optional user Python hook (the interpreter is only started when --python_hook is set)
+            PythonHook python_hook(sPythonHook);
+            if (!python_hook.Call("create_and_export_graph",
+                std::vector<IndexT>(set_ViewIds.begin(), set_ViewIds.end()), outputPairs, sMatchesDirectory))
+            {
+                return EXIT_FAILURE;
+            }
         }
-        using IndexT = int; 
-        using ViewIds = std::vector<IndexT>;
-        const char* python_module_name = "geometric_graph";
-        const char* python_function_name = "create_and_export_graph";
-        if (!py_module.def(python_function_name)) {
-            std::cerr << "Error: Unable to find function " << python_function_name << " in module " << python_module_name << std::endl;
-            return 1;
-        }
-        ViewIds view_ids = { 1, 2, 3, 4, 5 }; 
-        std::vector<std::pair<IndexT, IndexT>> outputPairs = { {1, 2}, {2, 3}, {3, 4} };
-        std::string sMatchesDirectory = "/path/to/matches/directory"; 
-        py::object py_result = py_module.attr(python_function_name)(view_ids, outputPairs, sMatchesDirectory);
 
         // Write pairs
         if (!sOutputPairsFilename.empty())
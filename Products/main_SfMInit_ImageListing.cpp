@@ -1,269 +1,794 @@
-#include "openMVG/cameras/cameras.hpp"
-#include "openMVG/exif/exif_IO_EasyExif.hpp"
-#include "openMVG/exif/sensor_width_database/ParseDatabase.hpp"
-#include "openMVG/geodesy/geodesy.hpp"
-#include "openMVG/image/image_io.hpp"
-#include "openMVG/numeric/eigen_alias_definition.hpp"
-#include "openMVG/sfm/sfm_data.hpp"
-#include "openMVG/sfm/sfm_data_io.hpp"
-#include "openMVG/sfm/sfm_data_utils.hpp"
-#include "openMVG/sfm/sfm_view.hpp"
-#include "openMVG/sfm/sfm_view_priors.hpp"
-#include "openMVG/system/loggerprogress.hpp"
-#include "openMVG/types.hpp"
-//openMVGͷļ
-#include "third_party/cmdLine/cmdLine.h"
-#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
-//ͷļ
-#include <pybind11/pybind11.h>
-#include <pybind11/embed.h>
-#include <fstream>
-#include <memory>
-#include <string>
-#include <utility>
-#include <iostream>
-#include <pybind11/stl.h>
-//׼ͷļ
-
-namespace py = pybind11;
-using namespace std;
-using namespace openMVG;
-using namespace openMVG::cameras;
-using namespace openMVG::exif;
-using namespace openMVG::geodesy;
-using namespace openMVG::image;
-using namespace openMVG::sfm;
-//ʹռ
-
-/// ԽԤȨַsWeightsɢvec_strȻ뵽ֵ-ԣﷵءȻû룬main˳ʼֵԽ<True,1.0ɵ>
-std::pair<bool, Vec3> checkPriorWeightsString
-(
-  const std::string &sWeights
-)
-{
-  std::pair<bool, Vec3> val(true, Vec3::Zero());
-  std::vector<std::string> vec_str;
-  stl::split(sWeights, ';', vec_str);
-  if (vec_str.size() != 3)
-  {
-    OPENMVG_LOG_ERROR << "Missing ';' character in prior weights";
-    val.first = false;
-  }
-  for (size_t i = 0; i < vec_str.size(); ++i)
-  {
-    double readvalue = 0.0;
-    std::stringstream ss;
-    ss.str(vec_str[i]);
-    if (! (ss >> readvalue) )  {
-      OPENMVG_LOG_ERROR << "Used an invalid not a number character in local frame origin";
-      val.first = false;
-    }
-    val.second[i] = readvalue;
-  }
-  return val;
-}
-
-int main(int argc, char **argv)
-{
-  py::scoped_interpreter guard{};
-
-  auto python_code = py::module_::import("main_SfMInit_ImageListing");  // Pythonģ
-  auto read_datafile = python_code.attr("read_datafile");  // ȡPython
-  auto read_input = python_code.attr("read_input");
-  auto read_output = python_code.attr("read_output");
-  auto search_size = python_code.attr("search_size");
-  auto files_name = python_code.attr("files_name");
-  auto help_log = python_code.attr("help_log");
-
-  std::string sImageDir, sfileDatabase = "", sOutputDir = "";
-
-  std::string sPriorWeights = "1.0;1.0;1.0";
-  std::pair<bool, Vec3> prior_w_info(false, Vec3());
-  
-  bool b_Group_camera_model = true;
-
-  int i_GPS_XYZ_method = 0;
-
-  double focal_pixels = -1.0;
-  double sensorSize = 0.0;
-
-  auto ImageDir = read_input();
-  auto fileDatabase = read_datafile();
-  auto OutputDir = read_output();
-
-  sImageDir = py::str(ImageDir).cast<std::string>();
-  sfileDatabase = py::str(fileDatabase).cast<std::string>();
-  sOutputDir = py::str(OutputDir).cast<std::string>();
-
-  if (sImageDir == "ERROR" || sfileDatabase == "ERROR" || sOutputDir == "ERROR") {
-      // 
-      return EXIT_FAILURE;
-  }
-  
-  //˴Ӧ쳣ɲ
-  OPENMVG_LOG_INFO << "Usage: " << argv[0] << '\n'
-      << "[-i|--imageDirectory]\n"
-      << "[-d|--sensorWidthDatabase]\n"
-      << "[-o|--outputDirectory]\n";
-
-  double width = -1, height = -1, focal = -1, ppx = -1,  ppy = -1;
-  
-  const EINTRINSIC e_User_camera_model = EINTRINSIC(PINHOLE_CAMERA_RADIAL3);
-
-  if ( !stlplus::folder_exists( sImageDir ) )
-  {
-    OPENMVG_LOG_ERROR << "The input directory doesn't exist";
-    return EXIT_FAILURE;
-  }
-
-  if (sOutputDir.empty())
-  {
-    OPENMVG_LOG_ERROR << "Invalid output directory";
-    return EXIT_FAILURE;
-  }
-
-  if ( !stlplus::folder_exists( sOutputDir ) )
-  {
-    if ( !stlplus::folder_create( sOutputDir ))
-    {
-      OPENMVG_LOG_ERROR << "Cannot create output directory";
-      return EXIT_FAILURE;
-    }
-  }
-  
-  //ͼֵvec_image
-  py::object result = files_name(sImageDir); // Pythonȡ
-  std::vector<std::string> vec_image = py::cast<std::vector<std::string>>(result); // ת
-
-  SfM_Data sfm_data;
-  sfm_data.s_root_path = sImageDir; // Setup main image root_path
-  Views & views = sfm_data.views; 
-  Intrinsics & intrinsics = sfm_data.intrinsics;
-
-  //ʵһmy_progress_barڸٺʾгͼĽȡ
-  //һstd::ostringstreamʵerror_report_streamռпܷĴϢ
-  system::LoggerProgress my_progress_bar(vec_image.size(), "- Listing images -" );
-  std::ostringstream error_report_stream;
-
-  for ( std::vector<std::string>::const_iterator iter_image = vec_image.begin();
-    iter_image != vec_image.end();
-    ++iter_image, ++my_progress_bar )
-  {
-    width = height = ppx = ppy = focal = -1.0;
-    // ȡ·ļsImageFilenameͲ·ļsImFilenamePart
-    const std::string sImageFilename = stlplus::create_filespec( sImageDir, *iter_image );
-    const std::string sImFilenamePart = stlplus::filename_part(sImageFilename);
-
-    // GetFormatTest if the image format is supported:
-    if (openMVG::image::GetFormat(sImageFilename.c_str()) == openMVG::image::Unknown)
-    {
-      error_report_stream
-          << sImFilenamePart << ": Unkown image file format." << "\n";
-      continue; // image cannot be openedԾcontinueһͼƬ
-    }
-    
-    //ȡͷϢаͼwidthheightppxppy㣨ĵ㣩
-    ImageHeader imgHeader;
-    if (!openMVG::image::ReadImageHeader(sImageFilename.c_str(), &imgHeader))
-      continue; // image cannot be read
-    width = imgHeader.width;
-    height = imgHeader.height;
-    ppx = width / 2.0;
-    ppy = height / 2.0;
-
-
-    //˴focalҪһ
-    if (focal == -1)
-    {
-      std::unique_ptr<Exif_IO> exifReader(new Exif_IO_EasyExif);
-      exifReader->open( sImageFilename );
-      //exifReaderܣָüͷĳԱûкʵexifƷͺ
-      const bool bHaveValidExifMetadata =
-        exifReader->doesHaveExifInfo()
-        && !exifReader->getModel().empty()
-        && !exifReader->getBrand().empty();
-      /*
-         EXIFеĽֵΪ0¼ϢfocalΪ-1.0
-         EXIFЧϢͨѯǰصvec_databaseݿ⣬ȡӦģ͵Ĵߴ磨sensorSize_ԼʵʵĽֵͨͼ봫ߴıEXIFеĽֵɡ
-         ݿвڶӦģͣ¼ϢûģͺʹӵݿС
-       */
-      if (bHaveValidExifMetadata) // If image contains meta data
-      {
-        // Handle case where focal length is equal to 0
-        if (exifReader->getFocal() == 0.0f)
-        {
-          error_report_stream
-            << stlplus::basename_part(sImageFilename) << ": Focal length is missing." << "\n";
-          focal = -1.0;
-        }
-        else
-        // Create the image entry in the list file
-        {
-            //Ʒģַ
-          const std::string sCamModel = exifReader->getBrand() + " " + exifReader->getModel();
-
-          if (py::object size = search_size(sCamModel, sfileDatabase))
-          {
-            //focal = max(w, h) * F / S,FΪ೤(focal lengthλmm)w, hΪͼƬĿߣSΪccd׾sensor sizeλmm
-            //*Ϊλ*
-            sensorSize = py::cast<double>(size);
-            const double ccdw = sensorSize;
-            focal = std::max ( width, height ) * exifReader->getFocal() / ccdw;
-          }
-          //СмݵĻͱ
-          else
-          {
-            error_report_stream
-              << stlplus::basename_part(sImageFilename)
-              << "\" model \"" << sCamModel << "\" doesn't exist in the database" << "\n"
-              << "Please consider add your camera model and sensor width in the database." << "\n";
-          }
-        }
-      }
-    }
-    // Build intrinsic parameter related to the view
-    // IntrinsicBaseָintrinsicᴢEXIFڲϢ
-    std::shared_ptr<IntrinsicBase> intrinsic;
-
-    if (focal > 0 && ppx > 0 && ppy > 0 && width > 0 && height > 0)
-    {
-      // Create the desired camera type
-        //std::make_sharedC++11һָ룬ڴһָ̬Ķstd::shared_ptrָ롣
-        //ˣpythonܷ
-      intrinsic = std::make_shared<Pinhole_Intrinsic_Radial_K3>
-        (width, height, focal, ppx, ppy, 0.0, 0.0, 0.0);
-      
-    // ͼӦͼҸͼǷЧGPSλϢͼ
-    Vec3 pose_center;
-
-    View v(*iter_image, views.size(), views.size(), views.size(), width, height);
-
-    intrinsics[v.id_intrinsic] = intrinsic;
-    views[v.id_view] = std::make_shared<View>(v);
-  }
-
-  if (!error_report_stream.str().empty())
-  {
-    OPENMVG_LOG_WARNING
-      << "Warning & Error messages:\n"
-      << error_report_stream.str();
-  }
-  GroupSharedIntrinsics(sfm_data);
-
-  // Store SfM_Data views & intrinsic dataSave
-  if (!Save(
-    sfm_data, //ͼƬͼڲϢ
-    stlplus::create_filespec( sOutputDir, "sfm_data.json" ).c_str(),  //ȷļ·sfm_data.json
-    ESfM_Data(VIEWS|INTRINSICS)))  // ͨVIEWS|INTRINSICS־ָʾͼڲϢ
-  {
-    return EXIT_FAILURE;
-  }
-
-  OPENMVG_LOG_INFO //С
-    << "SfMInit_ImageListing report:\n"
-    << "listed #File(s): " << vec_image.size() << "\n"
-    << "usable #File(s) listed in sfm_data: " << sfm_data.GetViews().size() << "\n"
-    << "usable #Intrinsic(s) listed in sfm_data: " << sfm_data.GetIntrinsics().size();
-
-  return EXIT_SUCCESS;
-}
+#include "openMVG/cameras/cameras.hpp"
+#include "openMVG/exif/exif_IO_EasyExif.hpp"
+#include "openMVG/geodesy/geodesy.hpp"
+#include "openMVG/image/image_converter.hpp"
+#include "openMVG/image/image_io.hpp"
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_io.hpp"
+#include "openMVG/sfm/sfm_view.hpp"
+#include "openMVG/sfm/sfm_view_priors.hpp"
+#include "openMVG/stl/hash.hpp"
+#include "openMVG/system/loggerprogress.hpp"
+#include "openMVG/types.hpp"
+//openMVG库头文件
+#include "third_party/cmdLine/cmdLine.h"
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+//第三方库头文件
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <iostream>
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <unordered_map>
+//标准库头文件
+#ifdef OPENMVG_USE_OPENMP
+#include <omp.h>
+#endif
+#include "image_listing_cache.hpp"
+#include "image_directory_enumerator.hpp"
+#include "image_pyramid_cache.hpp"
+#include "image_quality.hpp"
+#include "near_duplicate_index.hpp"
+#include "python_hook.hpp"
+#include "image_listing_record.hpp"
+#include "sfm_data_indexed_io.hpp"
+#include "video_frame_reader.hpp"
+#include "video_keyframe_selector.hpp"
+#include "view_position_index.hpp"
+#include "sensor_width_database_index.hpp"
+
+using namespace std;
+using namespace openMVG;
+using namespace openMVG::cameras;
+using namespace openMVG::exif;
+using namespace openMVG::geodesy;
+using namespace openMVG::image;
+using namespace openMVG::sfm;
+using namespace openMVG::system;
+//使用命名空间
+
+/// 尝试将预设权重字符串sWeights打散成vec_str然后输入到返回值（布尔-向量对）里返回。虽然参数没输入，但是main里设了初始值，所以结果是<True,三个1.0组成的向量>。
+std::pair<bool, Vec3> checkPriorWeightsString
+(
+  const std::string &sWeights
+)
+{
+  std::pair<bool, Vec3> val(true, Vec3::Zero());
+  std::vector<std::string> vec_str;
+  stl::split(sWeights, ';', vec_str);
+  if (vec_str.size() != 3)
+  {
+    OPENMVG_LOG_ERROR << "Missing ';' character in prior weights";
+    val.first = false;
+  }
+  for (size_t i = 0; i < vec_str.size(); ++i)
+  {
+    double readvalue = 0.0;
+    std::stringstream ss;
+    ss.str(vec_str[i]);
+    if (! (ss >> readvalue) )  {
+      OPENMVG_LOG_ERROR << "Used an invalid not a number character in local frame origin";
+      val.first = false;
+    }
+    val.second[i] = readvalue;
+  }
+  return val;
+}
+
+/// Identify the intrinsics that can be shared by several views
+struct IntrinsicKey
+{
+  EINTRINSIC type;
+  double width, height, focal;
+
+  bool operator==(const IntrinsicKey & rhs) const
+  {
+    return type == rhs.type && width == rhs.width
+      && height == rhs.height && focal == rhs.focal;
+  }
+};
+
+struct IntrinsicKeyHash
+{
+  std::size_t operator()(const IntrinsicKey & key) const
+  {
+    std::size_t seed = 0;
+    stl::hash_combine(seed, static_cast<int>(key.type));
+    stl::hash_combine(seed, key.width);
+    stl::hash_combine(seed, key.height);
+    stl::hash_combine(seed, key.focal);
+    return seed;
+  }
+};
+
+/// Read the header & EXIF data of one image.
+/// Only local data is modified, so several images can be scanned concurrently.
+ImageListingRecord ScanImage
+(
+  const std::string & sImageFilename,
+  const SensorWidthDatabaseIndex & sensor_database
+)
+{
+  ImageListingRecord record;
+  std::ostringstream error_report_stream;
+  // 获取不含路径的文件名sImFilenamePart
+  const std::string sImFilenamePart = stlplus::filename_part(sImageFilename);
+
+  // 用GetFormat来Test if the image format is supported:
+  if (openMVG::image::GetFormat(sImageFilename.c_str()) == openMVG::image::Unknown)
+  {
+    error_report_stream
+        << sImFilenamePart << ": Unkown image file format." << "\n";
+    record.error_report = error_report_stream.str();
+    return record; // image cannot be opened
+  }
+
+  //读取头信息，其中包括图像width和height。ppx和ppy是主点（中心点）的坐标
+  ImageHeader imgHeader;
+  if (!openMVG::image::ReadImageHeader(sImageFilename.c_str(), &imgHeader))
+    return record; // image cannot be read
+  record.b_readable = true;
+  const double width = record.width = imgHeader.width;
+  const double height = record.height = imgHeader.height;
+  record.ppx = width / 2.0;
+  record.ppy = height / 2.0;
+
+  //此处focal要改一改
+  if (record.focal == -1)
+  {
+    std::unique_ptr<Exif_IO> exifReader(new Exif_IO_EasyExif);
+    exifReader->open( sImageFilename );
+    //用exifReader（智能（？）指针所以用箭头）的成员函数检查有没有合适的exif：有品牌且有型号
+    const bool bHaveValidExifMetadata =
+      exifReader->doesHaveExifInfo()
+      && !exifReader->getModel().empty()
+      && !exifReader->getBrand().empty();
+    /*
+       如果EXIF数据中的焦距值为0，记录错误信息，并将focal设为-1.0。
+       如果EXIF中有有效焦距信息，则通过查询前面加载的vec_database数据库，获取相应相机模型的传感器尺寸（sensorSize_），以计算实际的焦距值。这通过图像最长边与传感器尺寸的比例乘以EXIF中的焦距值来完成。
+       如果数据库中不存在对应的相机模型，记录错误信息，建议用户将相机模型和传感器宽度添加到数据库中。
+     */
+    if (bHaveValidExifMetadata) // If image contains meta data
+    {
+      // Handle case where focal length is equal to 0
+      if (exifReader->getFocal() == 0.0f)
+      {
+        error_report_stream
+          << stlplus::basename_part(sImageFilename) << ": Focal length is missing." << "\n";
+        record.focal = -1.0;
+      }
+      else
+      // Create the image entry in the list file
+      {
+          //品牌模型字符串
+        const std::string sCamModel = exifReader->getBrand() + " " + exifReader->getModel();
+        record.camera_model = sCamModel;
+
+        double ccdw = 0.0;
+        if (sensor_database.Find(exifReader->getBrand(), exifReader->getModel(), ccdw))
+        {
+          //focal = max(w, h) * F / S,其中F为相机焦距长度(focal length，单位毫米mm)，w, h为图片的宽高，S为ccd传感器孔径（sensor size，单位mm）
+          //算出来*以像素为单位的*焦距
+          record.focal = std::max ( width, height ) * exifReader->getFocal() / ccdw;
+        }
+        //如果你用小米相机又妹有加数据的话就报错
+        else
+        {
+          error_report_stream
+            << stlplus::basename_part(sImageFilename)
+            << "\" model \"" << sCamModel << "\" doesn't exist in the database" << "\n"
+            << "Please consider add your camera model and sensor width in the database." << "\n";
+        }
+      }
+    }
+
+    // GPS position, converted to XYZ later on (in batch, once the listing is done)
+    double latitude, longitude, altitude;
+    if (exifReader->doesHaveExifInfo()
+        && exifReader->GPSLatitude(&latitude)
+        && exifReader->GPSLongitude(&longitude)
+        && exifReader->GPSAltitude(&altitude))
+    {
+      record.b_gps = true;
+      record.latitude = latitude;
+      record.longitude = longitude;
+      record.altitude = altitude;
+    }
+  }
+  record.error_report = error_report_stream.str();
+  return record;
+}
+
+int main(int argc, char **argv)
+{
+  CmdLine cmd;
+
+  std::string sImageDir, sfileDatabase = "", sOutputDir = "";
+
+  std::string sPriorWeights = "1.0;1.0;1.0";
+  std::pair<bool, Vec3> prior_w_info(false, Vec3());
+  
+  int i_Group_camera_model = 1;
+
+  int i_GPS_XYZ_method = 0;
+
+  double focal_pixels = -1.0;
+
+  int iNumThreads = 0;
+  std::string sImageExtensions;
+  std::string sSfM_Data_Format = "json";
+  std::string sQualityScreening = "none";
+  double min_sharpness = 30.0;
+  double max_clipped_ratio = 0.5;
+  std::string sNearDuplicates = "none";
+  int i_Duplicate_distance = 6;
+  std::string sVideoFilename;
+  double keyframe_parallax = 0.05;
+  int i_Pyramid_levels = 0;
+  std::string sPythonHook;
+
+  // 参数直接在C++中解析：启动时不再加载Python解释器，
+  // 只有设置了 --python_hook 时才在用到时启动
+  cmd.add( make_option('i', sImageDir, "imageDirectory") );
+  cmd.add( make_option('d', sfileDatabase, "sensorWidthDatabase") );
+  cmd.add( make_option('o', sOutputDir, "outputDirectory") );
+  cmd.add( make_option('n', iNumThreads, "numThreads") );
+  cmd.add( make_switch('I', "incremental") );
+  cmd.add( make_switch('R', "recursive") );
+  cmd.add( make_option('e', sImageExtensions, "extensions") );
+  cmd.add( make_option('F', sSfM_Data_Format, "sfmDataFormat") );
+  cmd.add( make_option('g', i_Group_camera_model, "groupCameraModel") );
+  cmd.add( make_option('q', sQualityScreening, "qualityScreening") );
+  cmd.add( make_option('S', min_sharpness, "minSharpness") );
+  cmd.add( make_option('C', max_clipped_ratio, "maxClippedRatio") );
+  cmd.add( make_option('D', sNearDuplicates, "nearDuplicates") );
+  cmd.add( make_option('H', i_Duplicate_distance, "duplicateDistance") );
+  cmd.add( make_option('V', sVideoFilename, "video") );
+  cmd.add( make_option('K', keyframe_parallax, "keyframeParallax") );
+  cmd.add( make_option('f', focal_pixels, "focal") );
+  cmd.add( make_option('P', i_Pyramid_levels, "pyramidLevels") );
+  cmd.add( make_switch('U', "usePosePrior") );
+  cmd.add( make_option('W', sPriorWeights, "priorWeights") );
+  cmd.add( make_option('m', i_GPS_XYZ_method, "gpsToXyzMethod") );
+  cmd.add( make_option('y', sPythonHook, "python_hook") );
+
+  try
+  {
+    if (argc == 1) throw std::string("Invalid command line parameter.");
+    cmd.process(argc, argv);
+  }
+  catch (const std::string& s)
+  {
+    OPENMVG_LOG_INFO << "Usage: " << argv[0] << '\n'
+        << "[-i|--imageDirectory]\n"
+        << "[-d|--sensorWidthDatabase]\n"
+        << "[-o|--outputDirectory]\n"
+        << "[-n|--numThreads] number of parallel header & EXIF readers (0: all cores)\n"
+        << "[-I|--incremental] only scan new or changed images and keep the existing view ids\n"
+        << "[-R|--recursive] list the images of the sub-directories too\n"
+        << "[-e|--extensions] \"jpg;png;...\" image file extensions to list (default: all files)\n"
+        << "[-F|--sfmDataFormat] sfm_data output format:\n"
+        << "\t json: (default) openMVG json\n"
+        << "\t bin: openMVG binary\n"
+        << "\t ibin: indexed binary, views & intrinsics can be loaded individually\n"
+        << "[-g|--groupCameraModel]\n"
+        << "\t 0-> each view has its own camera intrinsic parameters,\n"
+        << "\t 1-> (default) views sharing the same size, focal & camera model share their intrinsic\n"
+        << "[-q|--qualityScreening] blur & exposure pre-screening on a decimated grayscale image:\n"
+        << "\t none: (default) no screening\n"
+        << "\t tag: keep all the views, report the low quality ones in image_quality.txt\n"
+        << "\t drop: do not list the low quality views\n"
+        << "[-S|--minSharpness] minimal variance of the Laplacian (default 30)\n"
+        << "[-C|--maxClippedRatio] maximal ratio of under/over exposed pixels (default 0.5)\n"
+        << "[-D|--nearDuplicates] perceptual hash clustering of near-identical images:\n"
+        << "\t none: (default) no clustering\n"
+        << "\t mark: keep all the views, list the duplicates in near_duplicates.txt (see PairGenerator -s)\n"
+        << "\t drop: only list one representative view per cluster\n"
+        << "[-H|--duplicateDistance] maximal Hamming distance between 64 bit hashes (default 6)\n"
+        << "[-V|--video] video file to list instead of an image directory (needs ffmpeg):\n"
+        << "\t only the keyframes are written, in <outputDirectory>/keyframes\n"
+        << "[-K|--keyframeParallax] median point displacement between keyframes, ratio of the frame size (default 0.05)\n"
+        << "[-f|--focal] (pixels), used for all the views when set\n"
+        << "[-P|--pyramidLevels] write a decoded grayscale pyramid of each image (full resolution\n"
+        << "\t + downsampled levels) in <outputDirectory>/pyramid_cache (default 0: disabled)\n"
+        << "[-U|--usePosePrior] Use pose prior if GPS EXIF pose is available\n"
+        << "[-W|--priorWeights] \"x;y;z;\" of weights for each dimension of the prior (default: 1.0)\n"
+        << "[-m|--gpsToXyzMethod] XYZ Coordinate system:\n"
+        << "\t 0: ECEF (default)\n"
+        << "\t 1: UTM\n"
+        << "\t 2: local ENU, tangent at the first GPS position\n"
+        << "The GPS positions are also written in <outputDirectory>/view_positions.bin (see PairGenerator NEIGHBORS)\n"
+        << "[-y|--python_hook] optional Python module, its on_listing_done(sfm_data_file) is called at the end\n";
+
+    OPENMVG_LOG_ERROR << s;
+    return EXIT_FAILURE;
+  }
+
+  const bool b_Incremental = cmd.used('I');
+  const bool b_Recursive = cmd.used('R');
+  const bool b_Group_camera_model = i_Group_camera_model != 0;
+  const bool b_Use_pose_prior = cmd.used('U');
+  PythonHook python_hook(sPythonHook);
+
+  const EINTRINSIC e_User_camera_model = EINTRINSIC(PINHOLE_CAMERA_RADIAL3);
+
+  if ( sVideoFilename.empty() && !stlplus::folder_exists( sImageDir ) )
+  {
+    OPENMVG_LOG_ERROR << "The input directory doesn't exist";
+    return EXIT_FAILURE;
+  }
+
+  if (sSfM_Data_Format != "json" && sSfM_Data_Format != "bin" && sSfM_Data_Format != "ibin")
+  {
+    OPENMVG_LOG_ERROR << "Unknown sfm_data format: " << sSfM_Data_Format;
+    return EXIT_FAILURE;
+  }
+
+  if (i_GPS_XYZ_method < 0 || i_GPS_XYZ_method > 2)
+  {
+    OPENMVG_LOG_ERROR << "Invalid GPS to XYZ method: " << i_GPS_XYZ_method;
+    return EXIT_FAILURE;
+  }
+
+  if (b_Use_pose_prior)
+  {
+    prior_w_info = checkPriorWeightsString(sPriorWeights);
+  }
+
+  if (sQualityScreening != "none" && sQualityScreening != "tag" && sQualityScreening != "drop")
+  {
+    OPENMVG_LOG_ERROR << "Unknown quality screening mode: " << sQualityScreening;
+    return EXIT_FAILURE;
+  }
+  const bool b_Quality_screening = sQualityScreening != "none";
+  if (sNearDuplicates != "none" && sNearDuplicates != "mark" && sNearDuplicates != "drop")
+  {
+    OPENMVG_LOG_ERROR << "Unknown near duplicates mode: " << sNearDuplicates;
+    return EXIT_FAILURE;
+  }
+  const bool b_Near_duplicates = sNearDuplicates != "none";
+  // Largest side of the decimated image used for the quality scores & perceptual hash
+  const int decimated_image_size = 512;
+
+  if (sOutputDir.empty())
+  {
+    OPENMVG_LOG_ERROR << "Invalid output directory";
+    return EXIT_FAILURE;
+  }
+
+  if ( !stlplus::folder_exists( sOutputDir ) )
+  {
+    if ( !stlplus::folder_create( sOutputDir ))
+    {
+      OPENMVG_LOG_ERROR << "Cannot create output directory";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Load the sensor width database once, indexed by normalized camera model
+  SensorWidthDatabaseIndex sensor_database;
+  if (!sensor_database.Load(sfileDatabase))
+  {
+    OPENMVG_LOG_ERROR
+      << "Invalid input database: " << sfileDatabase
+      << ", please specify a valid file.";
+    return EXIT_FAILURE;
+  }
+
+  // Video listing: the frames are streamed from ffmpeg and tracked on a small
+  // grayscale copy; only the keyframes having enough parallax are written
+  // (they become the listed images).
+  std::vector<std::string> vec_keyframe;
+  if (!sVideoFilename.empty())
+  {
+    sImageDir = stlplus::create_filespec( sOutputDir, "keyframes" );
+    if ( !stlplus::folder_exists( sImageDir ) && !stlplus::folder_create( sImageDir ) )
+    {
+      OPENMVG_LOG_ERROR << "Cannot create the keyframes directory: " << sImageDir;
+      return EXIT_FAILURE;
+    }
+    VideoFrameReader video_reader;
+    if (!video_reader.Open(sVideoFilename))
+    {
+      OPENMVG_LOG_ERROR << "Cannot decode the video: " << sVideoFilename;
+      return EXIT_FAILURE;
+    }
+    // Largest side of the frames used for the tracking
+    const int flow_image_size = 320;
+    VideoKeyframeSelector keyframe_selector(keyframe_parallax);
+    Image<RGBColor> frame;
+    Image<unsigned char> gray_frame, flow_frame;
+    size_t frame_count = 0;
+    while (video_reader.Read(frame))
+    {
+      ConvertPixelType(frame, &gray_frame);
+      DecimateImage(gray_frame, flow_image_size, flow_frame);
+      if (keyframe_selector.AddFrame(flow_frame))
+      {
+        std::ostringstream keyframe_name;
+        keyframe_name << "frame_" << std::setw(6) << std::setfill('0') << frame_count << ".jpg";
+        if (!WriteImage(stlplus::create_filespec( sImageDir, keyframe_name.str() ).c_str(), frame))
+        {
+          OPENMVG_LOG_ERROR << "Cannot write the keyframe: " << keyframe_name.str();
+          return EXIT_FAILURE;
+        }
+        vec_keyframe.push_back(keyframe_name.str());
+      }
+      ++frame_count;
+    }
+    OPENMVG_LOG_INFO
+      << "Video: " << vec_keyframe.size() << " keyframe(s) selected from "
+      << frame_count << " frame(s)";
+  }
+
+  SfM_Data sfm_data;
+  sfm_data.s_root_path = sImageDir; // Setup main image root_path
+  Views & views = sfm_data.views; 
+  Intrinsics & intrinsics = sfm_data.intrinsics;
+
+  const std::string sSfM_Data_Filename = stlplus::create_filespec( sOutputDir, "sfm_data", sSfM_Data_Format );
+  const std::string sListingCacheFilename = stlplus::create_filespec( sOutputDir, "image_listing_cache", "bin" );
+  const std::string sImageQualityFilename = stlplus::create_filespec( sOutputDir, "image_quality", "txt" );
+  const std::string sNearDuplicatesFilename = stlplus::create_filespec( sOutputDir, "near_duplicates", "txt" );
+  const std::string sPyramidCacheDir = stlplus::create_filespec( sOutputDir, "pyramid_cache" );
+  const std::string sViewPositionsFilename = stlplus::create_filespec( sOutputDir, "view_positions", "bin" );
+
+  // Incremental listing:
+  // - the metadata of unchanged files (same relative path, size & mtime) is read from the cache,
+  // - the images already listed in sfm_data keep their view id, new ones are appended.
+  ImageListingCache previous_listing_cache(sImageDir, GetFileStamp(sfileDatabase));
+  ImageListingCache listing_cache(sImageDir, GetFileStamp(sfileDatabase));
+  std::map<std::string, IndexT> map_previous_view_id;
+  IndexT next_view_id = 0;
+  if (b_Incremental)
+  {
+    previous_listing_cache.Load(sListingCacheFilename);
+
+    SfM_Data previous_sfm_data;
+    if (stlplus::file_exists(sSfM_Data_Filename)
+        && LoadSfMData(previous_sfm_data, sSfM_Data_Filename, ESfM_Data(VIEWS))
+        && previous_sfm_data.s_root_path == sImageDir)
+    {
+      for (const auto & view_it : previous_sfm_data.GetViews())
+      {
+        map_previous_view_id[view_it.second->s_Img_path] = view_it.first;
+        next_view_id = std::max(next_view_id, view_it.first + 1);
+      }
+    }
+  }
+
+  //实例化一个进度条my_progress_bar，用于跟踪和显示列出图像的进度。
+  //创建一个std::ostringstream实例error_report_stream，用于收集过程中可能发生的错误信息。
+  system::LoggerProgress my_progress_bar;
+  std::ostringstream error_report_stream;
+  size_t listed_count = 0;
+  std::atomic<int> scanned_count(0);
+  size_t low_quality_count = 0;
+  std::ostringstream quality_report_stream;
+  NearDuplicateIndex near_duplicate_index(i_Duplicate_distance);
+  size_t near_duplicate_count = 0;
+  std::ostringstream near_duplicates_stream;
+  // GPS (latitude, longitude, altitude) of the listed views, converted in batch
+  std::vector<IndexT> vec_gps_view_id;
+  std::vector<Vec3> vec_gps_lla;
+
+  // Shared intrinsics are found while listing (constant time per image):
+  // each distinct (camera model, width, height, focal) is allocated once.
+  std::unordered_map<IntrinsicKey, IndexT, IntrinsicKeyHash> map_shared_intrinsic_id;
+
+#ifdef OPENMVG_USE_OPENMP
+  const unsigned int nb_max_thread = omp_get_max_threads();
+  omp_set_num_threads(iNumThreads > 0 ? iNumThreads : nb_max_thread);
+#endif
+
+  // The image files are enumerated natively (natural order, optional
+  // recursion & extension filter) and listed batch by batch while the
+  // directory walk goes on.
+  //
+  // The features, masks and packed regions of a view are keyed by the image
+  // basename without extension (stlplus::basename_part, as in openMVG): two
+  // files sharing it (i.e a/img.jpg & b/img.jpg with -R, or img.jpg & img.png)
+  // would silently overwrite each other's features, so they are rejected.
+  // Only the files that become views are checked: a sidecar or raw file next
+  // to its image (i.e IMG_001.xmp or IMG_001.CR2 next to IMG_001.JPG) is not
+  // readable as an image and never collides.
+  std::map<std::string, std::string> map_basename_image;
+  std::string sDuplicate_basename_error;
+  const auto list_images = [&](const std::vector<std::string> & vec_image) -> bool
+  {
+    my_progress_bar.Restart(vec_image.size(), "- Listing images -");
+    listed_count += vec_image.size();
+    // Header & EXIF reading is I/O bound: scan the images concurrently, then
+    // assign the view & intrinsic ids serially in listing order so that
+    // the output is identical to a serial run.
+    std::vector<ImageListingRecord> vec_record(vec_image.size());
+    std::vector<FileStamp> vec_stamp(vec_image.size());
+#ifdef OPENMVG_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < static_cast<int>(vec_image.size()); ++i)
+    {
+      const std::string sImageFilename = stlplus::create_filespec( sImageDir, vec_image[i] );
+      vec_stamp[i] = GetFileStamp(sImageFilename);
+      const ImageListingRecord * cached_record = previous_listing_cache.Find(vec_image[i], vec_stamp[i]);
+      if (cached_record)
+      {
+        vec_record[i] = *cached_record;
+      }
+      else
+      {
+        vec_record[i] = ScanImage(sImageFilename, sensor_database);
+        ++scanned_count;
+      }
+      // Pyramid cache, quality scores & perceptual hash share the same decode
+      ImageListingRecord & record = vec_record[i];
+      const std::string sPyramidFilename = ImagePyramidCache::Filename(sPyramidCacheDir, vec_image[i]);
+      const bool b_write_pyramid = i_Pyramid_levels > 0 && record.b_readable
+        && !ImagePyramidCache().Open(sPyramidFilename, vec_stamp[i].size, vec_stamp[i].mtime);
+      if (record.b_readable
+          && (b_write_pyramid
+              || (b_Quality_screening && !record.b_quality_scored)
+              || (b_Near_duplicates && !record.b_perceptual_hash)))
+      {
+        Image<unsigned char> decimated_image;
+        bool b_decoded = false;
+        if (b_write_pyramid)
+        {
+          Image<unsigned char> image;
+          b_decoded = ReadImage(sImageFilename.c_str(), &image);
+          if (b_decoded)
+          {
+            if (!ImagePyramidCache::Write(sPyramidFilename, image, i_Pyramid_levels,
+                                          vec_stamp[i].size, vec_stamp[i].mtime))
+            {
+              OPENMVG_LOG_WARNING << "Cannot write the pyramid cache: " << sPyramidFilename;
+            }
+            DecimateImage(image, decimated_image_size, decimated_image);
+          }
+        }
+        else
+        {
+          b_decoded = ReadDecimatedImage(sImageFilename, decimated_image_size, decimated_image);
+        }
+        if (b_decoded)
+        {
+          if (b_Quality_screening && !record.b_quality_scored)
+          {
+            record.quality = ScoreImageQuality(decimated_image);
+            record.b_quality_scored = true;
+          }
+          if (b_Near_duplicates && !record.b_perceptual_hash)
+          {
+            // Images smaller than the hash grid are not hashed (never clustered)
+            record.b_perceptual_hash = ComputeDifferenceHash(decimated_image, record.perceptual_hash);
+          }
+        }
+      }
+      ++my_progress_bar;
+    }
+
+    for (size_t i = 0; i < vec_image.size(); ++i)
+    {
+      const ImageListingRecord & record = vec_record[i];
+      listing_cache.Insert(vec_image[i], vec_stamp[i], record);
+      error_report_stream << record.error_report;
+      if (!record.b_readable)
+        continue; // image cannot be read
+
+      if (b_Quality_screening && record.b_quality_scored
+          && (record.quality.sharpness < min_sharpness
+              || record.quality.clipped_ratio > max_clipped_ratio))
+      {
+        ++low_quality_count;
+        quality_report_stream
+          << vec_image[i] << ';' << record.quality.sharpness << ';'
+          << record.quality.clipped_ratio << '\n';
+        if (sQualityScreening == "drop")
+          continue;
+      }
+
+      // 构建与图像相对应的视图，并且根据图像是否具有有效的GPS位置信息来处理视图。
+      const auto it_previous_view_id = map_previous_view_id.find(vec_image[i]);
+      const bool b_new_view = it_previous_view_id == map_previous_view_id.end();
+      const IndexT id_view = b_new_view ? next_view_id : it_previous_view_id->second;
+
+      // Near-duplicates are clustered in listing order, the first image of a
+      // cluster being its representative
+      if (b_Near_duplicates && record.b_perceptual_hash)
+      {
+        const IndexT id_representative = near_duplicate_index.Insert(id_view, record.perceptual_hash);
+        if (id_representative != UndefinedIndexT)
+        {
+          ++near_duplicate_count;
+          if (sNearDuplicates == "drop")
+            continue;
+          near_duplicates_stream << id_view << ' ' << id_representative << '\n';
+        }
+      }
+      const auto it_basename = map_basename_image.emplace(stlplus::basename_part(vec_image[i]), vec_image[i]);
+      if (!it_basename.second)
+      {
+        sDuplicate_basename_error = "\"" + vec_image[i] + "\" and \"" + it_basename.first->second
+          + "\" have the same basename: their features would overwrite each other. Rename one of them.";
+        return false;
+      }
+      if (b_new_view)
+        ++next_view_id;
+
+      View v(vec_image[i], id_view, UndefinedIndexT, id_view, record.width, record.height);
+
+      // Build intrinsic parameter related to the view
+      const double focal = focal_pixels > 0 ? focal_pixels : record.focal;
+      if (focal > 0 && record.ppx > 0 && record.ppy > 0 && record.width > 0 && record.height > 0)
+      {
+        const IntrinsicKey intrinsic_key{e_User_camera_model, record.width, record.height, focal};
+        const auto it_shared_intrinsic = map_shared_intrinsic_id.find(intrinsic_key);
+        if (b_Group_camera_model && it_shared_intrinsic != map_shared_intrinsic_id.end())
+        {
+          v.id_intrinsic = it_shared_intrinsic->second;
+        }
+        else
+        {
+          v.id_intrinsic = b_Group_camera_model ?
+            static_cast<IndexT>(map_shared_intrinsic_id.size()) : id_view;
+          if (b_Group_camera_model)
+            map_shared_intrinsic_id[intrinsic_key] = v.id_intrinsic;
+          // Create the desired camera type
+          //std::make_shared是C++11引入的一种智能指针，它用于创建一个指向动态分配的对象的std::shared_ptr智能指针。
+          intrinsics[v.id_intrinsic] = std::make_shared<Pinhole_Intrinsic_Radial_K3>
+            (record.width, record.height, focal, record.ppx, record.ppy, 0.0, 0.0, 0.0);
+        }
+      }
+      views[v.id_view] = std::make_shared<View>(v);
+      if (record.b_gps)
+      {
+        vec_gps_view_id.push_back(v.id_view);
+        vec_gps_lla.emplace_back(record.latitude, record.longitude, record.altitude);
+      }
+    }
+    return true;
+  };
+
+  if (!sVideoFilename.empty())
+  {
+    list_images(vec_keyframe);
+  }
+  else
+  {
+    system::DirectoryEnumeratorOptions enumerator_options;
+    enumerator_options.b_recursive = b_Recursive;
+    stl::split(sImageExtensions, ';', enumerator_options.extensions);
+    system::DirectoryEnumerator directory_enumerator(sImageDir, enumerator_options);
+    if (!directory_enumerator.Enumerate(list_images))
+    {
+      OPENMVG_LOG_ERROR << "Cannot read the input directory: " << sImageDir;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!sDuplicate_basename_error.empty())
+  {
+    OPENMVG_LOG_ERROR << sDuplicate_basename_error;
+    return EXIT_FAILURE;
+  }
+
+  // Convert the GPS positions in batch, then store them as view priors and
+  // in a spatial index (so the next steps do not have to read EXIF again)
+  if (!vec_gps_lla.empty())
+  {
+    Mat3X lla(3, vec_gps_lla.size());
+    for (size_t i = 0; i < vec_gps_lla.size(); ++i)
+      lla.col(i) = vec_gps_lla[i];
+    Mat3X xyz;
+    switch (i_GPS_XYZ_method)
+    {
+      case 1:
+        xyz.resize(3, lla.cols());
+        for (Mat3X::Index i = 0; i < lla.cols(); ++i)
+          xyz.col(i) = lla_to_utm(lla(0, i), lla(1, i), lla(2, i));
+        break;
+      case 2:
+        xyz = EcefToEnu(LlaToEcef(lla), lla.col(0));
+        break;
+      case 0:
+      default:
+        xyz = LlaToEcef(lla);
+        break;
+    }
+
+    std::vector<std::pair<IndexT, Vec3>> view_positions;
+    view_positions.reserve(vec_gps_view_id.size());
+    for (size_t i = 0; i < vec_gps_view_id.size(); ++i)
+    {
+      view_positions.emplace_back(vec_gps_view_id[i], xyz.col(i));
+      if (!b_Use_pose_prior)
+        continue;
+      const View * view = views.at(vec_gps_view_id[i]).get();
+      ViewPriors v(view->s_Img_path, view->id_view, view->id_intrinsic, view->id_pose,
+                   view->ui_width, view->ui_height);
+      v.b_use_pose_center_ = true;
+      v.pose_center_ = xyz.col(i);
+      // prior weights
+      if (prior_w_info.first == true)
+      {
+        v.center_weight_ = prior_w_info.second;
+      }
+      views[v.id_view] = std::make_shared<ViewPriors>(v);
+    }
+
+    ViewPositionIndex view_position_index;
+    view_position_index.Build(view_positions);
+    if (!view_position_index.Save(sViewPositionsFilename))
+    {
+      OPENMVG_LOG_WARNING << "Cannot save the view positions index: " << sViewPositionsFilename;
+    }
+  }
+
+  if (!error_report_stream.str().empty())
+  {
+    OPENMVG_LOG_WARNING
+      << "Warning & Error messages:\n"
+      << error_report_stream.str();
+  }
+
+  // Store SfM_Data views & intrinsic data，用SaveSfMData函数
+  // (the "ibin" format is written directly with a per view offset index, so
+  // the next steps can load only the views they need)
+  if (!SaveSfMData(
+    sfm_data, //所有图片的视图和内参信息
+    sSfM_Data_Filename,  //确认输出文件路径并创建sfm_data.json（或.bin/.ibin）
+    ESfM_Data(VIEWS|INTRINSICS)))  // 通过VIEWS|INTRINSICS标志，指示函数仅保存视图和内参信息。
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (b_Quality_screening)
+  {
+    std::ofstream quality_report(sImageQualityFilename.c_str());
+    quality_report
+      << "# low quality images (" << sQualityScreening << "): path;sharpness;clipped_ratio\n"
+      << quality_report_stream.str();
+    if (!quality_report)
+    {
+      OPENMVG_LOG_WARNING << "Cannot save the image quality report: " << sImageQualityFilename;
+    }
+  }
+
+  if (sNearDuplicates == "mark")
+  {
+    std::ofstream near_duplicates(sNearDuplicatesFilename.c_str());
+    near_duplicates
+      << "# near-duplicate views: view_id representative_view_id\n"
+      << near_duplicates_stream.str();
+    if (!near_duplicates)
+    {
+      OPENMVG_LOG_WARNING << "Cannot save the near duplicates list: " << sNearDuplicatesFilename;
+    }
+  }
+
+  if (!listing_cache.Save(sListingCacheFilename))
+  {
+    OPENMVG_LOG_WARNING << "Cannot save the image listing cache: " << sListingCacheFilename;
+  }
+
+  // 可选的用户Python钩子（未设置 --python_hook 时不启动解释器）
+  if (!python_hook.Call("on_listing_done", sSfM_Data_Filename))
+  {
+    return EXIT_FAILURE;
+  }
+
+  OPENMVG_LOG_INFO //打小报告
+    << "SfMInit_ImageListing report:\n"
+    << "listed #File(s): " << listed_count << "\n"
+    << "scanned #File(s) (new or changed): " << scanned_count.load() << "\n"
+    << "low quality #File(s) (" << sQualityScreening << "): " << low_quality_count << "\n"
+    << "near-duplicate #File(s) (" << sNearDuplicates << "): " << near_duplicate_count << "\n"
+    << "GPS located #File(s): " << vec_gps_lla.size() << "\n"
+    << "usable #File(s) listed in sfm_data: " << sfm_data.GetViews().size() << "\n"
+    << "usable #Intrinsic(s) listed in sfm_data: " << sfm_data.GetIntrinsics().size();
+
+  return EXIT_SUCCESS;
+}
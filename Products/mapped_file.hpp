@@ -0,0 +1,133 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_MAPPED_FILE_HPP
+#define PRODUCTS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#include <process.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openMVG {
+namespace system {
+
+/// Read-only memory mapping of a whole file.
+/// The mapping is released when the object is destroyed.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile() { close(); }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  bool open(const std::string & filename)
+  {
+    close();
+#ifdef _WIN32
+    file_ = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0)
+    {
+      close();
+      return false;
+    }
+    mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_)
+    {
+      close();
+      return false;
+    }
+    data_ = static_cast<const char *>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    void * ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+    if (ptr == MAP_FAILED)
+      return false;
+    data_ = static_cast<const char *>(ptr);
+    size_ = static_cast<std::size_t>(st.st_size);
+#endif
+    if (!data_)
+    {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close()
+  {
+#ifdef _WIN32
+    if (data_) ::UnmapViewOfFile(data_);
+    if (mapping_) ::CloseHandle(mapping_);
+    if (file_ != INVALID_HANDLE_VALUE) ::CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = INVALID_HANDLE_VALUE;
+#else
+    if (data_) ::munmap(const_cast<char *>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  bool is_open() const { return data_ != nullptr; }
+  const char * data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  const char * data_ = nullptr;
+  std::size_t size_ = 0;
+#ifdef _WIN32
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#endif
+};
+
+/// Name of a temporary file next to filename, unique to this process.
+/// Write it completely then rename it over filename: a reader that maps the
+/// previous file keeps its own copy (POSIX) and never sees a partial file.
+inline std::string TemporaryFilename(const std::string & filename)
+{
+#ifdef _WIN32
+  return filename + ".tmp" + std::to_string(::_getpid());
+#else
+  return filename + ".tmp" + std::to_string(::getpid());
+#endif
+}
+
+} // namespace system
+} // namespace openMVG
+
+#endif // PRODUCTS_MAPPED_FILE_HPP
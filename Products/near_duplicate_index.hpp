@@ -0,0 +1,131 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_NEAR_DUPLICATE_INDEX_HPP
+#define PRODUCTS_NEAR_DUPLICATE_INDEX_HPP
+
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/types.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace openMVG {
+namespace image {
+
+/// 64 bit difference hash (dHash) of a grayscale image:
+/// the image is box sampled on a 9x8 grid and each bit tells if a cell is
+/// brighter than its right neighbour. Near-identical images have hashes
+/// within a small Hamming distance.
+/// Return false for images smaller than the grid: their cells would be empty
+/// and all such images would share the same hash.
+inline bool ComputeDifferenceHash(const Image<unsigned char> & image, std::uint64_t & hash)
+{
+  const int w = image.Width(), h = image.Height();
+  if (w < 9 || h < 8)
+    return false;
+  double cells[8][9];
+  for (int cy = 0; cy < 8; ++cy)
+  {
+    const int y0 = cy * h / 8, y1 = (cy + 1) * h / 8;
+    for (int cx = 0; cx < 9; ++cx)
+    {
+      const int x0 = cx * w / 9, x1 = (cx + 1) * w / 9;
+      double sum = 0.0;
+      for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+          sum += image(y, x);
+      cells[cy][cx] = sum / std::max(1, (y1 - y0) * (x1 - x0));
+    }
+  }
+  hash = 0;
+  for (int cy = 0; cy < 8; ++cy)
+    for (int cx = 0; cx < 8; ++cx)
+      hash = (hash << 1) | (cells[cy][cx] > cells[cy][cx + 1] ? 1 : 0);
+  return true;
+}
+
+inline int HammingDistance(std::uint64_t a, std::uint64_t b)
+{
+  return static_cast<int>(std::bitset<64>(a ^ b).count());
+}
+
+} // namespace image
+
+namespace sfm {
+
+/// Greedy near-duplicate clustering of 64 bit perceptual hashes.
+///
+/// Multi-index hashing: the hash is split in (max_distance + 1) chunks, so
+/// two hashes within max_distance share at least one identical chunk
+/// (pigeonhole principle). Only the hashes sharing a chunk with the query are
+/// compared, which avoids any all-pairs comparison.
+/// The first image of a cluster is its representative; the following ones
+/// are reported as duplicates of the closest representative.
+class NearDuplicateIndex
+{
+public:
+  explicit NearDuplicateIndex(int max_distance)
+    : max_distance_(std::max(0, std::min(max_distance, 63))),
+      tables_(max_distance_ + 1)
+  {}
+
+  /// Return the id of the representative image the hash duplicates, or
+  /// UndefinedIndexT if the hash starts a new cluster (id is then registered).
+  IndexT Insert(IndexT id, std::uint64_t hash)
+  {
+    IndexT best_id = UndefinedIndexT;
+    int best_distance = max_distance_ + 1;
+    for (std::size_t i = 0; i < tables_.size(); ++i)
+    {
+      const auto it = tables_[i].find(Chunk(hash, i));
+      if (it == tables_[i].cend())
+        continue;
+      for (const std::size_t representative : it->second)
+      {
+        const int distance = image::HammingDistance(hash, representatives_[representative].second);
+        if (distance > max_distance_)
+          continue;
+        if (distance < best_distance
+            || (distance == best_distance && representatives_[representative].first < best_id))
+        {
+          best_distance = distance;
+          best_id = representatives_[representative].first;
+        }
+      }
+    }
+    if (best_id != UndefinedIndexT)
+      return best_id;
+
+    for (std::size_t i = 0; i < tables_.size(); ++i)
+      tables_[i][Chunk(hash, i)].push_back(representatives_.size());
+    representatives_.emplace_back(id, hash);
+    return UndefinedIndexT;
+  }
+
+private:
+  /// Bits [64 * i / n, 64 * (i + 1) / n) of the hash
+  std::uint64_t Chunk(std::uint64_t hash, std::size_t i) const
+  {
+    const std::size_t n = tables_.size();
+    const std::size_t begin = 64 * i / n, end = 64 * (i + 1) / n;
+    const std::size_t bits = end - begin;
+    const std::uint64_t mask = bits >= 64 ? ~std::uint64_t(0) : ((std::uint64_t(1) << bits) - 1);
+    return (hash >> begin) & mask;
+  }
+
+  int max_distance_;
+  std::vector<std::unordered_map<std::uint64_t, std::vector<std::size_t>>> tables_;
+  std::vector<std::pair<IndexT, std::uint64_t>> representatives_;
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_NEAR_DUPLICATE_INDEX_HPP
@@ -0,0 +1,93 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_PYTHON_HOOK_HPP
+#define PRODUCTS_PYTHON_HOOK_HPP
+
+#include "openMVG/system/logger.hpp"
+
+#include <pybind11/embed.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace openMVG {
+namespace system {
+
+/// Optional user Python module called at some steps of a binary.
+/// Nothing Python related is done unless a module name is configured: the
+/// interpreter is only started (and the module imported) on the first call.
+class PythonHook
+{
+public:
+  explicit PythonHook(const std::string & module_name = "")
+    : module_name_(module_name)
+  {}
+
+  PythonHook(const PythonHook &) = delete;
+  PythonHook & operator=(const PythonHook &) = delete;
+
+  ~PythonHook()
+  {
+    module_ = pybind11::module_(); // release the module before the interpreter
+    interpreter_.reset();
+  }
+
+  bool IsConfigured() const { return !module_name_.empty(); }
+
+  /// Call module.function_name(args...) if the module defines it.
+  /// Return false only if the hook is configured and failed.
+  template <typename... Args>
+  bool Call(const char * function_name, Args &&... args)
+  {
+    if (!IsConfigured())
+      return true;
+    if (!Start())
+      return false;
+    try
+    {
+      if (!pybind11::hasattr(module_, function_name))
+        return true;
+      module_.attr(function_name)(std::forward<Args>(args)...);
+    }
+    catch (const pybind11::error_already_set & e)
+    {
+      OPENMVG_LOG_ERROR << "Python hook " << module_name_ << '.' << function_name << ": " << e.what();
+      return false;
+    }
+    return true;
+  }
+
+private:
+  bool Start()
+  {
+    if (interpreter_)
+      return static_cast<bool>(module_);
+    interpreter_.reset(new pybind11::scoped_interpreter());
+    try
+    {
+      module_ = pybind11::module_::import(module_name_.c_str());
+    }
+    catch (const pybind11::error_already_set & e)
+    {
+      OPENMVG_LOG_ERROR << "Cannot import the Python hook module " << module_name_ << ": " << e.what();
+      return false;
+    }
+    return true;
+  }
+
+  std::string module_name_;
+  std::unique_ptr<pybind11::scoped_interpreter> interpreter_;
+  pybind11::module_ module_;
+};
+
+} // namespace system
+} // namespace openMVG
+
+#endif // PRODUCTS_PYTHON_HOOK_HPP
@@ -0,0 +1,689 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_REGIONS_PACK_HPP
+#define PRODUCTS_REGIONS_PACK_HPP
+
+#include "openMVG/features/feature.hpp"
+#include "openMVG/features/regions.hpp"
+#include "openMVG/features/regions_factory.hpp"
+#include "openMVG/sfm/pipelines/sfm_features_provider.hpp"
+#include "openMVG/sfm/pipelines/sfm_regions_provider.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/system/logger.hpp"
+#include "openMVG/system/progressinterface.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include "compact_descriptors.hpp"
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace openMVG {
+namespace features {
+
+/// Packed regions container: the features and descriptors of all the views
+/// in one append-only file (<matches_dir>/regions.pack) instead of one
+/// .feat/.desc pair per view.
+///
+/// The file is a sequence of self-describing records:
+///   RegionsPackRecordHeader | key | regions type | pad
+///   | feature_count x (x, y, scale, orientation) float | descriptors | pad
+/// The payloads are 16-byte aligned so that a read-only mapping gives
+/// zero-copy views of the features and descriptors. A view written twice is
+/// read from its last record. Each record is appended with a single write
+/// on a file opened in append mode, so several writers (threads or
+/// processes) can fill the same container.
+///
+/// The offset index (regions.pack.index) is rewritten when a writer is
+/// closed. Readers use it when it matches the container size and scan the
+/// record headers otherwise. Every record is checked against the container
+/// size before its payload is read.
+///
+/// The regions type of a record is its regions class name (RegionsTypeName):
+/// SIFT, RootSIFT and AKAZE binary records share a Type_id and a descriptor
+/// size, but are never read as one another. The regions providers hand out
+/// the records as Mapped_Regions: the matchers read the descriptors in place.
+namespace regions_pack_internal {
+
+static const std::uint32_t kRecordMagic = 0x314E4752; // "RGN1"
+static const char kIndexMagic[8] = {'O', 'M', 'V', 'G', 'R', 'I', 'D', 'X'};
+static const std::uint64_t kAlignment = 16;
+
+inline std::uint64_t Align(std::uint64_t size)
+{
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/// Distance of two descriptors of sizeof(DescriptorT) bytes, as the regions
+/// types: squared L2 for scalar descriptors, Hamming for binary ones
+template <typename BinT>
+double DescriptorDistance(const unsigned char * a, const unsigned char * b, std::size_t bytes, bool bBinary)
+{
+  double distance = 0.0;
+  if (bBinary)
+  {
+    for (std::size_t i = 0; i < bytes; ++i)
+      distance += std::bitset<8>(a[i] ^ b[i]).count();
+    return distance;
+  }
+  for (std::size_t i = 0; i < bytes; i += sizeof(BinT))
+  {
+    BinT bin_a, bin_b;
+    std::memcpy(&bin_a, a + i, sizeof(BinT));
+    std::memcpy(&bin_b, b + i, sizeof(BinT));
+    const double difference = static_cast<double>(bin_a) - static_cast<double>(bin_b);
+    distance += difference * difference;
+  }
+  return distance;
+}
+
+/// Descriptor type of a regions type and its bin (element) type
+template <typename RegionsT>
+using DescriptorOf = typename std::remove_reference<decltype(std::declval<RegionsT &>().Descriptors())>::type::value_type;
+template <typename DescriptorT>
+using BinOf = typename std::decay<decltype(std::declval<const DescriptorT &>()[0])>::type;
+
+} // namespace regions_pack_internal
+
+/// Storage of the descriptors in a record (the descriptors of the regions
+/// type, as is)
+enum ERegionsPackDescriptorEncoding : std::uint16_t
+{
+  kDescriptorRaw = 0
+};
+
+struct RegionsPackRecordHeader
+{
+  std::uint32_t magic;
+  std::uint32_t key_length;
+  std::uint32_t type_length;
+  std::uint16_t feature_stride;   // floats per feature
+  std::uint16_t descriptor_encoding;
+  std::uint64_t feature_count;
+  std::uint64_t descriptor_bytes;
+  std::uint64_t record_size;      // header included, multiple of 16
+};
+
+/// Zero-copy view of the regions of one view in a mapped container
+struct PackedRegionsView
+{
+  std::string regions_type;
+  const float * features = nullptr;   // feature_count x feature_stride
+  std::size_t feature_count = 0;
+  std::size_t feature_stride = 0;
+  std::uint16_t descriptor_encoding = kDescriptorRaw;
+  const unsigned char * descriptors = nullptr;
+  std::size_t descriptor_bytes = 0;
+};
+
+inline std::string RegionsPackFilename(const std::string & directory)
+{
+  return stlplus::create_filespec(directory, "regions", "pack");
+}
+
+/// Call functor(typed_regions) with the concrete type of the regions
+/// (the SIOPointFeature region types of regions_factory and the compact
+/// descriptors ones; the derived types are tested first)
+template <typename Functor>
+bool VisitPackableRegions(Regions * regions, Functor && functor)
+{
+  if (auto * root_sift = dynamic_cast<RootSIFT_Regions *>(regions))
+    return functor(*root_sift);
+  if (auto * pca64 = dynamic_cast<PCA64_Regions *>(regions))
+    return functor(*pca64);
+  if (auto * sift = dynamic_cast<SIFT_Regions *>(regions))
+    return functor(*sift);
+  if (auto * akaze_float = dynamic_cast<AKAZE_Float_Regions *>(regions))
+    return functor(*akaze_float);
+  if (auto * akaze_binary = dynamic_cast<AKAZE_Binary_Regions *>(regions))
+    return functor(*akaze_binary);
+  return false;
+}
+
+/// Name of the regions class, as registered in image_describer.json
+/// (empty if the regions cannot be packed)
+inline std::string RegionsTypeName(const Regions & regions)
+{
+  if (dynamic_cast<const RootSIFT_Regions *>(&regions))
+    return "RootSIFT_Regions";
+  if (dynamic_cast<const PCA64_Regions *>(&regions))
+    return "PCA64_Regions";
+  if (dynamic_cast<const SIFT_Regions *>(&regions))
+    return "SIFT_Regions";
+  if (dynamic_cast<const AKAZE_Float_Regions *>(&regions))
+    return "AKAZE_Float_Regions";
+  if (dynamic_cast<const AKAZE_Binary_Regions *>(&regions))
+    return "AKAZE_Binary_Regions";
+  return std::string();
+}
+
+/// Read side: mapped container and its offset index
+class RegionsPack
+{
+public:
+  bool Open(const std::string & filename)
+  {
+    offsets_.clear();
+    if (!file_.open(filename))
+      return false;
+    if (!LoadIndex(filename + ".index"))
+      BuildIndex();
+    return true;
+  }
+
+  bool Contains(const std::string & key) const { return offsets_.count(key) != 0; }
+
+  /// The view has a valid record of this regions type (see RegionsTypeName)
+  bool Contains(const std::string & key, const std::string & regions_type) const
+  {
+    PackedRegionsView view;
+    return Get(key, view) && view.regions_type == regions_type;
+  }
+  std::size_t Size() const { return offsets_.size(); }
+
+  bool Get(const std::string & key, PackedRegionsView & view) const
+  {
+    const auto it = offsets_.find(key);
+    if (it == offsets_.end() || it->second > file_.size()
+        || file_.size() - it->second < sizeof(RegionsPackRecordHeader))
+      return false;
+    RegionsPackRecordHeader header;
+    std::memcpy(&header, file_.data() + it->second, sizeof(header));
+    const char * record = file_.data() + it->second + sizeof(header);
+    if (!ValidRecord(header, it->second, file_.size())
+        || key.compare(0, std::string::npos, record, header.key_length) != 0)
+    {
+      OPENMVG_LOG_ERROR << "Regions pack: invalid record for " << key << " at offset " << it->second;
+      return false;
+    }
+    view.regions_type.assign(record + header.key_length, header.type_length);
+    const char * payload = file_.data() + it->second + regions_pack_internal::Align(
+      sizeof(header) + header.key_length + header.type_length);
+    view.features = reinterpret_cast<const float *>(payload);
+    view.feature_count = static_cast<std::size_t>(header.feature_count);
+    view.feature_stride = header.feature_stride;
+    view.descriptor_encoding = header.descriptor_encoding;
+    view.descriptors = reinterpret_cast<const unsigned char *>(
+      payload + header.feature_count * header.feature_stride * sizeof(float));
+    view.descriptor_bytes = static_cast<std::size_t>(header.descriptor_bytes);
+    return true;
+  }
+
+  /// Write the offset index next to the container.
+  /// The index is written to a temporary file renamed over the previous one:
+  /// a reader opening the container meanwhile never sees a partial index.
+  bool SaveIndex(const std::string & index_filename) const
+  {
+    const std::string temporary_filename = system::TemporaryFilename(index_filename);
+    {
+      std::ofstream stream(temporary_filename, std::ios::binary | std::ios::trunc);
+      if (!stream)
+        return false;
+      const std::uint64_t pack_size = file_.size(), entry_count = offsets_.size();
+      stream.write(regions_pack_internal::kIndexMagic, sizeof(regions_pack_internal::kIndexMagic));
+      stream.write(reinterpret_cast<const char *>(&pack_size), sizeof(pack_size));
+      stream.write(reinterpret_cast<const char *>(&entry_count), sizeof(entry_count));
+      for (const auto & offset_it : offsets_)
+      {
+        const std::uint32_t key_length = static_cast<std::uint32_t>(offset_it.first.size());
+        stream.write(reinterpret_cast<const char *>(&key_length), sizeof(key_length));
+        stream.write(offset_it.first.data(), key_length);
+        stream.write(reinterpret_cast<const char *>(&offset_it.second), sizeof(offset_it.second));
+      }
+      if (!stream)
+      {
+        stream.close();
+        stlplus::file_delete(temporary_filename);
+        return false;
+      }
+    }
+    if (stlplus::file_rename(temporary_filename, index_filename)
+        || (stlplus::file_delete(index_filename) && stlplus::file_rename(temporary_filename, index_filename)))
+      return true;
+    stlplus::file_delete(temporary_filename);
+    return false;
+  }
+
+private:
+  /// Use the index only if it was written for the current container size
+  bool LoadIndex(const std::string & index_filename)
+  {
+    std::ifstream stream(index_filename, std::ios::binary);
+    char magic[sizeof(regions_pack_internal::kIndexMagic)];
+    std::uint64_t pack_size = 0, entry_count = 0;
+    if (!stream.read(magic, sizeof(magic))
+        || std::memcmp(magic, regions_pack_internal::kIndexMagic, sizeof(magic)) != 0
+        || !stream.read(reinterpret_cast<char *>(&pack_size), sizeof(pack_size))
+        || !stream.read(reinterpret_cast<char *>(&entry_count), sizeof(entry_count))
+        || pack_size != file_.size())
+      return false;
+    for (std::uint64_t i = 0; i < entry_count; ++i)
+    {
+      std::uint32_t key_length = 0;
+      std::uint64_t offset = 0;
+      std::string key;
+      bool valid = stream.read(reinterpret_cast<char *>(&key_length), sizeof(key_length))
+        && key_length <= file_.size();
+      if (valid)
+      {
+        key.resize(key_length);
+        valid = stream.read(&key[0], key_length)
+          && stream.read(reinterpret_cast<char *>(&offset), sizeof(offset))
+          && offset + sizeof(RegionsPackRecordHeader) <= file_.size();
+      }
+      if (!valid)
+      {
+        offsets_.clear();
+        return false;
+      }
+      offsets_[key] = offset;
+    }
+    return true;
+  }
+
+  /// Hop from record header to record header; a truncated last record
+  /// (interrupted writer) ends the scan
+  void BuildIndex()
+  {
+    std::uint64_t offset = 0;
+    while (offset + sizeof(RegionsPackRecordHeader) <= file_.size())
+    {
+      RegionsPackRecordHeader header;
+      std::memcpy(&header, file_.data() + offset, sizeof(header));
+      if (!ValidRecord(header, offset, file_.size()))
+      {
+        OPENMVG_LOG_WARNING << "Regions pack: invalid record at offset " << offset
+          << ", the remaining records are ignored.";
+        break;
+      }
+      offsets_[std::string(file_.data() + offset + sizeof(header), header.key_length)] = offset;
+      offset += header.record_size;
+    }
+  }
+
+  /// The record lies in the container and its key, type, features and
+  /// descriptors fit in the record. Each length is bounded by the record size
+  /// before the lengths are summed, so the sums cannot overflow.
+  static bool ValidRecord
+  (
+    const RegionsPackRecordHeader & header,
+    std::uint64_t offset,
+    std::uint64_t file_size
+  )
+  {
+    using namespace regions_pack_internal;
+    const std::uint64_t record_size = header.record_size;
+    if (header.magic != kRecordMagic
+        || record_size < sizeof(header) || record_size % kAlignment != 0
+        || offset > file_size || record_size > file_size - offset
+        || header.key_length > record_size || header.type_length > record_size
+        || header.descriptor_bytes > record_size)
+      return false;
+    const std::uint64_t payload_offset = Align(sizeof(header) + header.key_length + header.type_length);
+    const std::uint64_t feature_bytes = static_cast<std::uint64_t>(header.feature_stride) * sizeof(float);
+    if (payload_offset > record_size
+        || (feature_bytes > 0 && header.feature_count > record_size / feature_bytes)
+        || (feature_bytes == 0 && header.feature_count > 0))
+      return false;
+    return payload_offset + header.feature_count * feature_bytes + header.descriptor_bytes <= record_size;
+  }
+
+  system::MappedFile file_;
+  std::map<std::string, std::uint64_t> offsets_;
+};
+
+/// Regions of a view read in place from a mapped container (zero-copy): the
+/// features and the descriptor array handed to the matchers
+/// (DescriptorRawData) are those of the record. Type, descriptor length and
+/// metric are those of RegionsT. The mapping is kept alive by the regions.
+/// EmptyClone gives a RegionsT: regions copied out of them (CopyRegion) are
+/// regular regions.
+template <typename RegionsT>
+class Mapped_Regions : public Regions
+{
+public:
+  using DescriptorT = regions_pack_internal::DescriptorOf<RegionsT>;
+  using BinT = regions_pack_internal::BinOf<DescriptorT>;
+
+  Mapped_Regions
+  (
+    std::shared_ptr<const RegionsPack> pack,
+    const PackedRegionsView & view,
+    std::size_t count
+  )
+  : pack_(std::move(pack)),
+    features_(view.features),
+    descriptors_(view.descriptors),
+    count_(count)
+  {}
+
+  // Read-only: the regions are loaded through the pack, saved as RegionsT
+  bool Load(const std::string &, const std::string &) override { return false; }
+  bool LoadFeatures(const std::string &) override { return false; }
+  bool Save(const std::string & sfileNameFeats, const std::string & sfileNameDescs) const override
+  {
+    return ToRegions().Save(sfileNameFeats, sfileNameDescs);
+  }
+  bool SaveDesc(const std::string & sfileNameDescs) const override
+  {
+    return ToRegions().SaveDesc(sfileNameDescs);
+  }
+
+  bool IsScalar() const override { return prototype_.IsScalar(); }
+  bool IsBinary() const override { return prototype_.IsBinary(); }
+  std::string Type_id() const override { return prototype_.Type_id(); }
+  size_t DescriptorLength() const override { return prototype_.DescriptorLength(); }
+
+  PointFeatures GetRegionsPositions() const override
+  {
+    PointFeatures positions;
+    positions.reserve(count_);
+    for (std::size_t i = 0; i < count_; ++i)
+      positions.emplace_back(features_[4 * i], features_[4 * i + 1]);
+    return positions;
+  }
+
+  Vec2 GetRegionPosition(size_t i) const override
+  {
+    return Vec2(features_[4 * i], features_[4 * i + 1]);
+  }
+
+  size_t RegionCount() const override { return count_; }
+
+  const void * DescriptorRawData() const override { return descriptors_; }
+
+  double SquaredDescriptorDistance(size_t i, const Regions * regions, size_t j) const override
+  {
+    return regions_pack_internal::DescriptorDistance<BinT>(
+      descriptors_ + i * sizeof(DescriptorT),
+      static_cast<const unsigned char *>(regions->DescriptorRawData()) + j * sizeof(DescriptorT),
+      sizeof(DescriptorT), IsBinary());
+  }
+
+  void CopyRegion(size_t i, Regions * regions) const override
+  {
+    RegionsT * typed_regions = dynamic_cast<RegionsT *>(regions);
+    if (!typed_regions)
+      return;
+    const float * feature = features_ + 4 * i;
+    typed_regions->Features().emplace_back(feature[0], feature[1], feature[2], feature[3]);
+    DescriptorT descriptor;
+    std::memcpy(static_cast<void *>(&descriptor), descriptors_ + i * sizeof(DescriptorT), sizeof(DescriptorT));
+    typed_regions->Descriptors().push_back(descriptor);
+  }
+
+  Regions * EmptyClone() const override { return new RegionsT; }
+
+private:
+  RegionsT ToRegions() const
+  {
+    RegionsT regions;
+    for (std::size_t i = 0; i < count_; ++i)
+      CopyRegion(i, &regions);
+    return regions;
+  }
+
+  std::shared_ptr<const RegionsPack> pack_;
+  const float * features_;
+  const unsigned char * descriptors_;
+  std::size_t count_;
+  RegionsT prototype_;
+};
+
+/// Zero-copy regions of a view (the first max_count of them): only the pages
+/// of these regions are read. Return nullptr when the view has no valid
+/// record of the regions type.
+inline std::unique_ptr<Regions> MapRegions
+(
+  const std::shared_ptr<const RegionsPack> & pack,
+  const std::string & key,
+  const Regions & region_type,
+  std::size_t max_count = std::numeric_limits<std::size_t>::max()
+)
+{
+  PackedRegionsView view;
+  std::unique_ptr<Regions> mapped;
+  if (!pack->Get(key, view) || view.regions_type != RegionsTypeName(region_type)
+      || view.feature_stride != 4 || view.descriptor_encoding != kDescriptorRaw)
+    return mapped;
+  VisitPackableRegions(const_cast<Regions *>(&region_type), [&](auto & typed_regions)
+  {
+    using RegionsT = typename std::decay<decltype(typed_regions)>::type;
+    if (view.descriptor_bytes != view.feature_count * sizeof(regions_pack_internal::DescriptorOf<RegionsT>))
+      return false;
+    mapped.reset(new Mapped_Regions<RegionsT>(pack, view, std::min(view.feature_count, max_count)));
+    return true;
+  });
+  return mapped;
+}
+
+/// Write side: append the regions of the views to a container
+class RegionsPackWriter
+{
+public:
+  RegionsPackWriter() = default;
+  ~RegionsPackWriter() { Close(); }
+
+  RegionsPackWriter(const RegionsPackWriter &) = delete;
+  RegionsPackWriter & operator=(const RegionsPackWriter &) = delete;
+
+  bool Open(const std::string & filename)
+  {
+    Close();
+#ifdef _WIN32
+    fd_ = ::_open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+    if (fd_ < 0)
+      return false;
+    filename_ = filename;
+    return true;
+  }
+
+  /// Append one record (thread safe, one write call)
+  bool Append(const std::string & key, const Regions & regions)
+  {
+    std::vector<char> record;
+    if (!Serialize(key, regions, record))
+      return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0)
+      return false;
+    std::size_t written = 0;
+    while (written < record.size())
+    {
+#ifdef _WIN32
+      const int count = ::_write(fd_, record.data() + written, static_cast<unsigned int>(record.size() - written));
+#else
+      const ssize_t count = ::write(fd_, record.data() + written, record.size() - written);
+#endif
+      if (count <= 0)
+        return false;
+      written += static_cast<std::size_t>(count);
+    }
+    return true;
+  }
+
+  /// Close the container and rewrite its offset index
+  bool Close()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0)
+      return true;
+#ifdef _WIN32
+    ::_close(fd_);
+#else
+    ::close(fd_);
+#endif
+    fd_ = -1;
+    RegionsPack pack;
+    return pack.Open(filename_) && pack.SaveIndex(filename_ + ".index");
+  }
+
+private:
+  static bool Serialize
+  (
+    const std::string & key,
+    const Regions & regions,
+    std::vector<char> & record
+  )
+  {
+    using namespace regions_pack_internal;
+    const std::string regions_type = RegionsTypeName(regions);
+    return VisitPackableRegions(const_cast<Regions *>(&regions), [&](auto & typed_regions)
+    {
+      using DescriptorT = regions_pack_internal::DescriptorOf<typename std::decay<decltype(typed_regions)>::type>;
+      const auto & features = typed_regions.Features();
+      const auto & descriptors = typed_regions.Descriptors();
+
+      RegionsPackRecordHeader header;
+      header.magic = kRecordMagic;
+      header.key_length = static_cast<std::uint32_t>(key.size());
+      header.type_length = static_cast<std::uint32_t>(regions_type.size());
+      header.feature_stride = 4;
+      header.descriptor_encoding = kDescriptorRaw;
+      header.feature_count = features.size();
+      header.descriptor_bytes = descriptors.size() * sizeof(DescriptorT);
+      const std::uint64_t payload_offset = Align(sizeof(header) + key.size() + regions_type.size());
+      header.record_size = Align(payload_offset
+        + header.feature_count * header.feature_stride * sizeof(float) + header.descriptor_bytes);
+
+      record.assign(static_cast<std::size_t>(header.record_size), 0);
+      char * data = record.data();
+      std::memcpy(data, &header, sizeof(header));
+      std::memcpy(data + sizeof(header), key.data(), key.size());
+      std::memcpy(data + sizeof(header) + key.size(), regions_type.data(), regions_type.size());
+      float * feature = reinterpret_cast<float *>(data + payload_offset);
+      for (const SIOPointFeature & sio : features)
+      {
+        *feature++ = sio.x();
+        *feature++ = sio.y();
+        *feature++ = sio.scale();
+        *feature++ = sio.orientation();
+      }
+      if (header.descriptor_bytes > 0)
+      {
+        std::memcpy(feature, static_cast<const void *>(descriptors.data()), header.descriptor_bytes);
+      }
+      return true;
+    });
+  }
+
+  std::mutex mutex_;
+  int fd_ = -1;
+  std::string filename_;
+};
+
+} // namespace features
+
+namespace sfm {
+
+/// Key of a view in the regions container: basename of its image, as the
+/// .feat/.desc files
+inline std::string RegionsPackKey(const View & view)
+{
+  return stlplus::basename_part(view.s_Img_path);
+}
+
+/// Regions_Provider reading a regions container (regions mapped in place)
+struct Packed_Regions_Provider : public Regions_Provider
+{
+  bool load
+  (
+    const SfM_Data & sfm_data,
+    const std::string & feat_directory,
+    std::unique_ptr<features::Regions> & region_type,
+    system::ProgressInterface * my_progress_bar = nullptr
+  ) override
+  {
+    auto pack = std::make_shared<features::RegionsPack>();
+    if (!pack->Open(features::RegionsPackFilename(feat_directory)))
+      return false;
+    if (!my_progress_bar)
+      my_progress_bar = &system::ProgressInterface::dummy();
+    region_type_.reset(region_type->EmptyClone());
+    my_progress_bar->Restart(sfm_data.GetViews().size(), "- Regions Loading -");
+    for (const auto & view_it : sfm_data.GetViews())
+    {
+      // Regions read in place from the mapping
+      std::unique_ptr<features::Regions> regions_ptr =
+        features::MapRegions(pack, RegionsPackKey(*view_it.second), *region_type);
+      if (!regions_ptr)
+      {
+        OPENMVG_LOG_ERROR << "Invalid regions in the pack for: " << view_it.second->s_Img_path;
+        return false;
+      }
+      cache_[view_it.first] = std::move(regions_ptr);
+      ++(*my_progress_bar);
+    }
+    return true;
+  }
+};
+
+/// Features_Provider reading the keypoints of a regions container
+struct Packed_Features_Provider : public Features_Provider
+{
+  bool load
+  (
+    const SfM_Data & sfm_data,
+    const std::string & feat_directory,
+    std::unique_ptr<features::Regions> & region_type,
+    system::ProgressInterface * my_progress_bar = nullptr
+  ) override
+  {
+    features::RegionsPack pack;
+    if (!pack.Open(features::RegionsPackFilename(feat_directory)))
+      return false;
+    if (!my_progress_bar)
+      my_progress_bar = &system::ProgressInterface::dummy();
+    my_progress_bar->Restart(sfm_data.GetViews().size(), "- Features Loading -");
+    for (const auto & view_it : sfm_data.GetViews())
+    {
+      features::PackedRegionsView view;
+      if (!pack.Get(RegionsPackKey(*view_it.second), view) || view.feature_stride != 4)
+      {
+        OPENMVG_LOG_ERROR << "Invalid features in the pack for: " << view_it.second->s_Img_path;
+        return false;
+      }
+      features::PointFeatures & features = feats_per_view[view_it.first];
+      features.reserve(view.feature_count);
+      for (std::size_t i = 0; i < view.feature_count; ++i)
+        features.emplace_back(view.features[4 * i], view.features[4 * i + 1]);
+      ++(*my_progress_bar);
+    }
+    return true;
+  }
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_REGIONS_PACK_HPP
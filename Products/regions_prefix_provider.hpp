@@ -0,0 +1,256 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_REGIONS_PREFIX_PROVIDER_HPP
+#define PRODUCTS_REGIONS_PREFIX_PROVIDER_HPP
+
+#include "openMVG/features/feature.hpp"
+#include "openMVG/features/regions.hpp"
+#include "openMVG/sfm/pipelines/sfm_preemptive_regions_provider.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/system/logger.hpp"
+#include "openMVG/system/progressinterface.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include "keypoint_selection.hpp"
+#include "regions_pack.hpp"
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/string.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+namespace openMVG {
+namespace features {
+
+/// Name of the image_describer.json entry written by ComputeFeatures when the
+/// regions are sorted by decreasing score. Its value is the score:
+/// "response" (detector response) or "scale" (keypoint scale).
+static const char kSortedRegionsEntry[] = "sorted_regions";
+
+/// Score the regions of a features directory are sorted by, read from its
+/// image_describer.json. Empty when the regions are written in detection
+/// order (no marker: older directories, or ComputeFeatures without -s).
+inline std::string SortedRegionsOrder(const std::string & feat_directory)
+{
+  std::ifstream stream(stlplus::create_filespec(feat_directory, "image_describer", "json"));
+  if (!stream)
+    return {};
+  std::string order;
+  try
+  {
+    cereal::JSONInputArchive archive(stream);
+    archive(cereal::make_nvp(kSortedRegionsEntry, order));
+  }
+  catch (const cereal::Exception &)
+  {
+    order.clear();
+  }
+  return order;
+}
+
+/// Count header of the sorted .feat files. The .feat format is read by the
+/// library as a plain list of features (a header line would be parsed as a
+/// feature), so the counts of a directory are stored next to them, one
+/// "count basename" line per view, the last line of a view wins.
+inline std::string RegionsCountsFilename(const std::string & directory)
+{
+  return stlplus::create_filespec(directory, "regions_counts", "txt");
+}
+
+inline bool LoadRegionsCounts
+(
+  const std::string & filename,
+  std::map<std::string, std::size_t> & counts
+)
+{
+  counts.clear();
+  std::ifstream stream(filename);
+  if (!stream)
+    return false;
+  std::size_t count = 0;
+  std::string basename;
+  while (stream >> count && stream.get() == ' ' && std::getline(stream, basename))
+    counts[basename] = count;
+  return stream.eof();
+}
+
+/// Write side: append the count of each saved .feat/.desc pair
+class RegionsCountsWriter
+{
+public:
+  bool Open(const std::string & filename)
+  {
+    stream_.open(filename, std::ios::out | std::ios::app);
+    return static_cast<bool>(stream_);
+  }
+
+  bool Append(const std::string & basename, std::size_t count)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_ << count << ' ' << basename << '\n';
+    stream_.flush();
+    return static_cast<bool>(stream_);
+  }
+
+private:
+  std::ofstream stream_;
+  std::mutex mutex_;
+};
+
+/// Read the first max_count regions of a .feat/.desc pair of feat_count
+/// regions (see RegionsCountsFilename).
+/// The .desc file starts with its descriptor count: only max_count
+/// descriptors are read after it, and only as many .feat lines.
+inline bool LoadRegionsPrefix
+(
+  const std::string & sFeat,
+  const std::string & sDesc,
+  std::size_t feat_count,
+  std::size_t max_count,
+  Regions * regions
+)
+{
+  return VisitPackableRegions(regions, [&](auto & typed_regions)
+  {
+    using DescriptorT = regions_pack_internal::DescriptorOf<typename std::decay<decltype(typed_regions)>::type>;
+    std::ifstream desc_stream(sDesc, std::ios::binary);
+    std::size_t desc_count = 0;
+    if (!desc_stream.read(reinterpret_cast<char *>(&desc_count), sizeof(desc_count))
+        || desc_count != feat_count)
+      return false;
+    const std::size_t count = std::min(desc_count, max_count);
+    auto & descriptors = typed_regions.Descriptors();
+    descriptors.resize(count);
+    if (count > 0 && !desc_stream.read(reinterpret_cast<char *>(descriptors.data()), count * sizeof(DescriptorT)))
+      return false;
+
+    std::ifstream feat_stream(sFeat);
+    auto & features = typed_regions.Features();
+    features.clear();
+    features.reserve(count);
+    SIOPointFeature feature;
+    while (features.size() < count && feat_stream >> feature)
+      features.push_back(feature);
+    return features.size() == count;
+  });
+}
+
+} // namespace features
+
+namespace sfm {
+
+/// Preemptive regions provider reading only the first max_feature_count
+/// regions of each view, from the regions container when there is one or
+/// from the .feat/.desc files. When ComputeFeatures wrote the regions sorted
+/// by decreasing score (-s, see SortedRegionsOrder), the prefix holds the
+/// best regions and the loading cost is proportional to max_feature_count
+/// instead of the region count. Otherwise the whole regions are read and
+/// the largest scale ones are kept, as Preemptive_Regions_Provider does.
+struct Prefix_Regions_Provider : public Preemptive_Regions_Provider
+{
+  explicit Prefix_Regions_Provider(std::size_t max_feature_count)
+    : Preemptive_Regions_Provider(max_feature_count),
+      max_feature_count_(max_feature_count)
+  {}
+
+  bool load
+  (
+    const SfM_Data & sfm_data,
+    const std::string & feat_directory,
+    std::unique_ptr<features::Regions> & region_type,
+    system::ProgressInterface * my_progress_bar = nullptr
+  ) override
+  {
+    auto pack = std::make_shared<features::RegionsPack>();
+    const std::string sRegionsPack = features::RegionsPackFilename(feat_directory);
+    const bool bPacked = stlplus::file_exists(sRegionsPack);
+    const bool bSorted = !features::SortedRegionsOrder(feat_directory).empty();
+    if (!bSorted)
+    {
+      OPENMVG_LOG_WARNING << "The regions of " << feat_directory
+        << " are not sorted (ComputeFeatures -s): the whole regions are read.";
+      if (!bPacked)
+        return Preemptive_Regions_Provider::load(sfm_data, feat_directory, region_type, my_progress_bar);
+    }
+    if (bPacked && !pack->Open(sRegionsPack))
+      return false;
+    std::map<std::string, std::size_t> feat_counts;
+    if (!bPacked && !features::LoadRegionsCounts(features::RegionsCountsFilename(feat_directory), feat_counts))
+    {
+      OPENMVG_LOG_ERROR << "Invalid regions count file: " << features::RegionsCountsFilename(feat_directory);
+      return false;
+    }
+    if (!my_progress_bar)
+      my_progress_bar = &system::ProgressInterface::dummy();
+    region_type_.reset(region_type->EmptyClone());
+    my_progress_bar->Restart(sfm_data.GetViews().size(), "- Regions Loading -");
+    for (const auto & view_it : sfm_data.GetViews())
+    {
+      const std::string sBasename = RegionsPackKey(*view_it.second);
+      // The prefix of a packed record is read in place
+      std::unique_ptr<features::Regions> regions_ptr;
+      bool bLoaded = false;
+      if (bPacked)
+      {
+        regions_ptr = features::MapRegions(pack, sBasename, *region_type,
+          bSorted ? max_feature_count_ : std::numeric_limits<std::size_t>::max());
+        bLoaded = static_cast<bool>(regions_ptr);
+        if (bLoaded && !bSorted)
+          regions_ptr = LargestScaleRegions(*regions_ptr);
+      }
+      else
+      {
+        const auto count_it = feat_counts.find(sBasename);
+        regions_ptr.reset(region_type->EmptyClone());
+        bLoaded = count_it != feat_counts.cend() && features::LoadRegionsPrefix(
+          stlplus::create_filespec(feat_directory, sBasename, "feat"),
+          stlplus::create_filespec(feat_directory, sBasename, "desc"),
+          count_it->second, max_feature_count_, regions_ptr.get());
+      }
+      if (!bLoaded)
+      {
+        OPENMVG_LOG_ERROR << "Invalid regions files for the view: " << view_it.second->s_Img_path;
+        return false;
+      }
+      cache_[view_it.first] = std::move(regions_ptr);
+      ++(*my_progress_bar);
+    }
+    return true;
+  }
+
+private:
+  /// The max_feature_count_ regions of largest scale (unsorted container).
+  /// The mapped regions are copied first: they are not Feat_Regions.
+  std::unique_ptr<features::Regions> LargestScaleRegions(const features::Regions & regions) const
+  {
+    std::unique_ptr<features::Regions> copied(regions.EmptyClone());
+    for (std::size_t i = 0; i < regions.RegionCount(); ++i)
+      regions.CopyRegion(i, copied.get());
+    std::unique_ptr<features::Regions> sorted = features::SortRegionsByScore(*copied);
+    const features::Regions & ordered = sorted ? *sorted : *copied;
+    std::unique_ptr<features::Regions> kept(regions.EmptyClone());
+    for (std::size_t i = 0; i < std::min(ordered.RegionCount(), max_feature_count_); ++i)
+      ordered.CopyRegion(i, kept.get());
+    return kept;
+  }
+
+  const std::size_t max_feature_count_;
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_REGIONS_PREFIX_PROVIDER_HPP
@@ -0,0 +1,307 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_SENSOR_WIDTH_DATABASE_INDEX_HPP
+#define PRODUCTS_SENSOR_WIDTH_DATABASE_INDEX_HPP
+
+#include "mapped_file.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openMVG {
+namespace exif {
+
+/// Normalize a camera "brand model" string so that EXIF and database spellings
+/// compare equal: lower case, single spaces, repeated tokens removed
+/// (i.e "Canon" + "Canon EOS 5D" -> "canon eos 5d").
+inline std::string NormalizeCameraModelKey(const std::string & sCamModel)
+{
+  std::istringstream iss(sCamModel);
+  std::vector<std::string> tokens;
+  std::string token;
+  while (iss >> token)
+  {
+    std::transform(token.begin(), token.end(), token.begin(),
+      [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (std::find(tokens.cbegin(), tokens.cend(), token) == tokens.cend())
+      tokens.push_back(token);
+  }
+  std::string key;
+  for (const auto & t : tokens)
+  {
+    if (!key.empty()) key += ' ';
+    key += t;
+  }
+  return key;
+}
+
+/// Sensor width database loaded once and indexed by normalized camera model.
+///
+/// Accepts the historical "model;sensor_width" text file, or its precompiled
+/// binary form which is memory-mapped and searched in place:
+///   header  : "OMVGSWDB" | uint32 version | uint32 #entries
+///             | uint64 source size | int64 source mtime (text database it was built from)
+///   entries : {uint64 key hash | uint32 key offset | uint32 key size | double width}
+///             sorted by key hash
+///   strings : concatenated normalized keys
+class SensorWidthDatabaseIndex
+{
+public:
+  /// Load a text or binary database.
+  /// For a text database, the "<filename>.bin" sidecar is used when it was
+  /// built from the same file (size and mtime recorded in its header),
+  /// otherwise it is (re)generated on a best effort basis for the next runs.
+  bool Load(const std::string & sfileDatabase)
+  {
+    if (IsBinaryDatabase(sfileDatabase))
+      return LoadBinary(sfileDatabase);
+
+    const std::uint64_t source_size = static_cast<std::uint64_t>(stlplus::file_size(sfileDatabase));
+    const std::int64_t source_mtime = static_cast<std::int64_t>(stlplus::file_modified(sfileDatabase));
+    const std::string sBinaryDatabase = sfileDatabase + ".bin";
+    if (stlplus::file_exists(sBinaryDatabase)
+        && LoadBinary(sBinaryDatabase)
+        && source_size_ == source_size
+        && source_mtime_ == source_mtime)
+      return true;
+
+    if (!LoadCSV(sfileDatabase))
+      return false;
+    source_size_ = source_size;
+    source_mtime_ = source_mtime;
+    SaveBinary(sBinaryDatabase); // a read-only database folder is not an error
+    return true;
+  }
+
+  /// Parse a "model;sensor_width" text database.
+  bool LoadCSV(const std::string & sfileDatabase)
+  {
+    std::ifstream stream(sfileDatabase.c_str());
+    if (!stream)
+      return false;
+
+    mapped_file_.close();
+    entries_ = nullptr;
+    entry_count_ = 0;
+    map_.clear();
+    source_size_ = 0;
+    source_mtime_ = 0;
+
+    std::string line;
+    while (std::getline(stream, line))
+    {
+      const std::string::size_type pos = line.find(';');
+      if (pos == std::string::npos)
+        continue;
+      double sensor_width = 0.0;
+      std::istringstream ss(line.substr(pos + 1));
+      if (!(ss >> sensor_width) || sensor_width <= 0.0)
+        continue;
+      const std::string key = NormalizeCameraModelKey(line.substr(0, pos));
+      if (!key.empty())
+        map_.emplace(key, sensor_width); // first occurrence wins, as in a linear scan
+    }
+    return !map_.empty();
+  }
+
+  /// Memory-map a precompiled database.
+  bool LoadBinary(const std::string & sfileDatabase)
+  {
+    map_.clear();
+    entries_ = nullptr;
+    entry_count_ = 0;
+    if (!mapped_file_.open(sfileDatabase))
+      return false;
+
+    const char * data = mapped_file_.data();
+    const std::size_t size = mapped_file_.size();
+    Header header;
+    if (size < sizeof(Header))
+    {
+      mapped_file_.close();
+      return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0
+        || header.version != kVersion
+        || size < sizeof(Header) + header.count * sizeof(Entry))
+    {
+      mapped_file_.close();
+      return false;
+    }
+    entries_ = reinterpret_cast<const Entry *>(data + sizeof(Header));
+    entry_count_ = header.count;
+    source_size_ = header.source_size;
+    source_mtime_ = header.source_mtime;
+    strings_ = data + sizeof(Header) + header.count * sizeof(Entry);
+    strings_size_ = size - sizeof(Header) - header.count * sizeof(Entry);
+    return true;
+  }
+
+  /// Write the precompiled form of the current index.
+  /// The file is written under a temporary name then renamed, so a concurrent
+  /// run that maps the previous file is not affected.
+  bool SaveBinary(const std::string & sfileDatabase) const
+  {
+    std::vector<std::pair<std::string, double>> items;
+    items.reserve(size());
+    if (entries_)
+    {
+      for (std::uint32_t i = 0; i < entry_count_; ++i)
+        items.emplace_back(std::string(strings_ + entries_[i].key_offset, entries_[i].key_size),
+                           entries_[i].sensor_width);
+    }
+    else
+      items.assign(map_.cbegin(), map_.cend());
+
+    std::vector<Entry> entries(items.size());
+    std::string strings;
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+      entries[i].hash = HashKey(items[i].first);
+      entries[i].key_offset = static_cast<std::uint32_t>(strings.size());
+      entries[i].key_size = static_cast<std::uint32_t>(items[i].first.size());
+      entries[i].sensor_width = items[i].second;
+      strings += items[i].first;
+    }
+    std::sort(entries.begin(), entries.end(),
+      [](const Entry & a, const Entry & b) { return a.hash < b.hash; });
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.count = static_cast<std::uint32_t>(entries.size());
+    header.source_size = source_size_;
+    header.source_mtime = source_mtime_;
+
+    const std::string temporary_filename = system::TemporaryFilename(sfileDatabase);
+    {
+      std::ofstream stream(temporary_filename.c_str(), std::ios::out | std::ios::binary);
+      if (!stream)
+        return false;
+      stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+      stream.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(Entry));
+      stream.write(strings.data(), strings.size());
+      if (!stream)
+      {
+        stream.close();
+        stlplus::file_delete(temporary_filename);
+        return false;
+      }
+    }
+    if (stlplus::file_rename(temporary_filename, sfileDatabase)
+        || (stlplus::file_delete(sfileDatabase) && stlplus::file_rename(temporary_filename, sfileDatabase)))
+      return true;
+    stlplus::file_delete(temporary_filename);
+    return false;
+  }
+
+  /// Retrieve the sensor width (mm) of an EXIF brand & model.
+  /// The model alone is tried as well since many brands repeat a vendor
+  /// name in the model field (i.e "NIKON CORPORATION" + "NIKON D90").
+  bool Find(const std::string & sBrand, const std::string & sModel, double & sensor_width) const
+  {
+    return FindKey(NormalizeCameraModelKey(sBrand + " " + sModel), sensor_width)
+        || FindKey(NormalizeCameraModelKey(sModel), sensor_width);
+  }
+
+  std::size_t size() const { return entries_ ? entry_count_ : map_.size(); }
+
+private:
+  struct Header
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+  };
+
+  struct Entry
+  {
+    std::uint64_t hash;
+    std::uint32_t key_offset;
+    std::uint32_t key_size;
+    double sensor_width;
+  };
+
+  static constexpr const char * kMagic = "OMVGSWDB";
+  static constexpr std::uint32_t kVersion = 2;
+
+  /// FNV-1a, stable across runs and platforms (std::hash is not).
+  static std::uint64_t HashKey(const std::string & key)
+  {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char c : key)
+    {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  static bool IsBinaryDatabase(const std::string & sfileDatabase)
+  {
+    std::ifstream stream(sfileDatabase.c_str(), std::ios::in | std::ios::binary);
+    char magic[8];
+    return stream.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(magic)) == 0;
+  }
+
+  bool FindKey(const std::string & key, double & sensor_width) const
+  {
+    if (key.empty())
+      return false;
+    if (!entries_)
+    {
+      const auto it = map_.find(key);
+      if (it == map_.cend())
+        return false;
+      sensor_width = it->second;
+      return true;
+    }
+    const std::uint64_t hash = HashKey(key);
+    const Entry * end = entries_ + entry_count_;
+    for (const Entry * it = std::lower_bound(entries_, end, hash,
+           [](const Entry & e, std::uint64_t h) { return e.hash < h; });
+         it != end && it->hash == hash; ++it)
+    {
+      if (it->key_offset + static_cast<std::size_t>(it->key_size) <= strings_size_
+          && key.compare(0, std::string::npos, strings_ + it->key_offset, it->key_size) == 0)
+      {
+        sensor_width = it->sensor_width;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Text database
+  std::unordered_map<std::string, double> map_;
+  // Precompiled database
+  system::MappedFile mapped_file_;
+  const Entry * entries_ = nullptr;
+  std::uint32_t entry_count_ = 0;
+  const char * strings_ = nullptr;
+  std::size_t strings_size_ = 0;
+  // Text database the index was built from
+  std::uint64_t source_size_ = 0;
+  std::int64_t source_mtime_ = 0;
+};
+
+} // namespace exif
+} // namespace openMVG
+
+#endif // PRODUCTS_SENSOR_WIDTH_DATABASE_INDEX_HPP
@@ -0,0 +1,340 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_SFM_DATA_INDEXED_IO_HPP
+#define PRODUCTS_SFM_DATA_INDEXED_IO_HPP
+
+#include "openMVG/cameras/cameras_io.hpp"
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/sfm/sfm_data_io.hpp"
+#include "openMVG/sfm/sfm_view_io.hpp"
+#include "openMVG/sfm/sfm_view_priors_io.hpp"
+#include "openMVG/system/logger.hpp"
+
+#include "third_party/stlplus3/filesystemSimplified/file_system.hpp"
+
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace openMVG {
+namespace sfm {
+
+/// Indexed binary SfM_Data (views & intrinsics only), extension ".ibin".
+///
+/// Every view and intrinsic is serialized as its own portable binary blob,
+/// and an index of the blob offsets is stored at the end of the file, so a
+/// reader can load a subset of the views (and only the intrinsics they use)
+/// without parsing the whole scene:
+///   "OMVGSFMI" | uint32 version | uint32 unused | uint64 index offset
+///   view & intrinsic blobs
+///   index: root path | view entries | intrinsic entries (sorted by id)
+struct SfM_Data_Index_Entry
+{
+  IndexT id = UndefinedIndexT;
+  IndexT id_intrinsic = UndefinedIndexT; // views only
+  std::uint64_t offset = 0;
+  std::uint64_t size = 0;
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(id, id_intrinsic, offset, size);
+  }
+};
+
+struct SfM_Data_Index
+{
+  std::string s_root_path;
+  std::vector<SfM_Data_Index_Entry> views;
+  std::vector<SfM_Data_Index_Entry> intrinsics;
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(s_root_path, views, intrinsics);
+  }
+};
+
+namespace indexed_io_internal {
+
+static const char kMagic[8] = {'O', 'M', 'V', 'G', 'S', 'F', 'M', 'I'};
+static const std::uint32_t kVersion = 1;
+
+struct Header
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t unused;
+  std::uint64_t index_offset;
+};
+
+template <typename T>
+bool WriteBlob
+(
+  std::ofstream & stream,
+  const T & object,
+  SfM_Data_Index_Entry & entry
+)
+{
+  std::ostringstream blob;
+  {
+    cereal::PortableBinaryOutputArchive archive(blob);
+    archive(object);
+  }
+  const std::string bytes = blob.str();
+  entry.offset = static_cast<std::uint64_t>(stream.tellp());
+  entry.size = bytes.size();
+  stream.write(bytes.data(), bytes.size());
+  return static_cast<bool>(stream);
+}
+
+template <typename T>
+bool ReadBlob
+(
+  std::ifstream & stream,
+  const SfM_Data_Index_Entry & entry,
+  T & object
+)
+{
+  std::string bytes(entry.size, '\0');
+  stream.seekg(entry.offset);
+  if (!stream.read(&bytes[0], bytes.size()))
+    return false;
+  std::istringstream blob(bytes);
+  cereal::PortableBinaryInputArchive archive(blob);
+  archive(object);
+  return true;
+}
+
+} // namespace indexed_io_internal
+
+inline bool IsIndexedSfMDataFile(const std::string & filename)
+{
+  return stlplus::extension_part(filename) == "ibin";
+}
+
+/// Save the views & intrinsics of a scene in the indexed binary format
+inline bool SaveIndexed
+(
+  const SfM_Data & sfm_data,
+  const std::string & filename
+)
+{
+  using namespace indexed_io_internal;
+  std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!stream)
+    return false;
+
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.unused = 0;
+  header.index_offset = 0;
+  stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+
+  SfM_Data_Index index;
+  index.s_root_path = sfm_data.s_root_path;
+  try
+  {
+    for (const auto & view_it : sfm_data.GetViews())
+    {
+      SfM_Data_Index_Entry entry;
+      entry.id = view_it.first;
+      entry.id_intrinsic = view_it.second->id_intrinsic;
+      if (!WriteBlob(stream, view_it.second, entry))
+        return false;
+      index.views.push_back(entry);
+    }
+    for (const auto & intrinsic_it : sfm_data.GetIntrinsics())
+    {
+      SfM_Data_Index_Entry entry;
+      entry.id = intrinsic_it.first;
+      if (!WriteBlob(stream, intrinsic_it.second, entry))
+        return false;
+      index.intrinsics.push_back(entry);
+    }
+    const auto by_id = [](const SfM_Data_Index_Entry & a, const SfM_Data_Index_Entry & b)
+      { return a.id < b.id; };
+    std::sort(index.views.begin(), index.views.end(), by_id);
+    std::sort(index.intrinsics.begin(), index.intrinsics.end(), by_id);
+
+    header.index_offset = static_cast<std::uint64_t>(stream.tellp());
+    {
+      cereal::PortableBinaryOutputArchive archive(stream);
+      archive(index);
+    }
+  }
+  catch (const cereal::Exception & e)
+  {
+    OPENMVG_LOG_ERROR << e.what();
+    return false;
+  }
+  // Now that the blobs are written, store where the index starts
+  stream.seekp(0);
+  stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+  return static_cast<bool>(stream);
+}
+
+/// Read the index of an indexed binary scene (no view is deserialized)
+inline bool LoadIndex
+(
+  const std::string & filename,
+  SfM_Data_Index & index
+)
+{
+  using namespace indexed_io_internal;
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  Header header;
+  if (!stream
+      || !stream.read(reinterpret_cast<char *>(&header), sizeof(Header))
+      || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+      || header.version != kVersion)
+    return false;
+  stream.seekg(header.index_offset);
+  try
+  {
+    cereal::PortableBinaryInputArchive archive(stream);
+    archive(index);
+  }
+  catch (const cereal::Exception & e)
+  {
+    OPENMVG_LOG_ERROR << e.what();
+    return false;
+  }
+  return true;
+}
+
+/// Load the views (all of them, or the ones listed in view_ids) of an indexed
+/// binary scene, and the intrinsics used by these views.
+inline bool LoadIndexed
+(
+  SfM_Data & sfm_data,
+  const std::string & filename,
+  const std::set<IndexT> * view_ids = nullptr
+)
+{
+  using namespace indexed_io_internal;
+  SfM_Data_Index index;
+  if (!LoadIndex(filename, index))
+    return false;
+
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!stream)
+    return false;
+  sfm_data.s_root_path = index.s_root_path;
+  std::set<IndexT> intrinsic_ids;
+  try
+  {
+    for (const auto & entry : index.views)
+    {
+      if (view_ids && view_ids->count(entry.id) == 0)
+        continue;
+      std::shared_ptr<View> view;
+      if (!ReadBlob(stream, entry, view))
+        return false;
+      sfm_data.views[entry.id] = view;
+      intrinsic_ids.insert(entry.id_intrinsic);
+    }
+    for (const auto & entry : index.intrinsics)
+    {
+      if (view_ids && intrinsic_ids.count(entry.id) == 0)
+        continue;
+      std::shared_ptr<cameras::IntrinsicBase> intrinsic;
+      if (!ReadBlob(stream, entry, intrinsic))
+        return false;
+      sfm_data.intrinsics[entry.id] = intrinsic;
+    }
+  }
+  catch (const cereal::Exception & e)
+  {
+    OPENMVG_LOG_ERROR << e.what();
+    return false;
+  }
+  return true;
+}
+
+/// Load a scene from any SfM_Data file.
+/// Indexed binary files only hold views & intrinsics, and can be loaded
+/// partially thanks to view_ids. For the other formats view_ids is ignored.
+inline bool LoadSfMData
+(
+  SfM_Data & sfm_data,
+  const std::string & filename,
+  ESfM_Data flags_part,
+  const std::set<IndexT> * view_ids = nullptr
+)
+{
+  if (!IsIndexedSfMDataFile(filename))
+    return Load(sfm_data, filename, flags_part);
+  if ((flags_part & ~(VIEWS | INTRINSICS)) != 0)
+  {
+    OPENMVG_LOG_ERROR << filename << " only stores views & intrinsics.";
+    return false;
+  }
+  return LoadIndexed(sfm_data, filename, view_ids);
+}
+
+/// Save a scene, the indexed binary format being selected by the ".ibin" extension
+inline bool SaveSfMData
+(
+  const SfM_Data & sfm_data,
+  const std::string & filename,
+  ESfM_Data flags_part
+)
+{
+  if (!IsIndexedSfMDataFile(filename))
+    return Save(sfm_data, filename, flags_part);
+  if ((flags_part & ~(VIEWS | INTRINSICS)) != 0)
+  {
+    OPENMVG_LOG_ERROR << filename << " can only store views & intrinsics.";
+    return false;
+  }
+  return SaveIndexed(sfm_data, filename);
+}
+
+/// Sorted view ids of a scene, read from the index only when possible.
+/// The ids are not always [0, #views): see view_id_pairs.hpp.
+inline bool GetSfMDataViewIds
+(
+  const std::string & filename,
+  std::vector<IndexT> & view_ids
+)
+{
+  view_ids.clear();
+  if (IsIndexedSfMDataFile(filename))
+  {
+    SfM_Data_Index index;
+    if (!LoadIndex(filename, index))
+      return false;
+    for (const auto & entry : index.views)
+      view_ids.push_back(entry.id);
+  }
+  else
+  {
+    SfM_Data sfm_data;
+    if (!Load(sfm_data, filename, ESfM_Data(VIEWS)))
+      return false;
+    for (const auto & view_it : sfm_data.GetViews())
+      view_ids.push_back(view_it.first);
+  }
+  std::sort(view_ids.begin(), view_ids.end());
+  return true;
+}
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_SFM_DATA_INDEXED_IO_HPP
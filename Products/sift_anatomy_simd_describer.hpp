@@ -0,0 +1,328 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_SIFT_ANATOMY_SIMD_DESCRIBER_HPP
+#define PRODUCTS_SIFT_ANATOMY_SIMD_DESCRIBER_HPP
+
+#include "openMVG/features/sift/SIFT_Anatomy_Image_Describer_io.hpp"
+#include "openMVG/features/sift/hierarchical_gaussian_scale_space.hpp"
+#include "openMVG/features/sift/sift_DescriptorExtractor.hpp"
+#include "openMVG/features/sift/sift_KeypointExtractor.hpp"
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/image/image_resampling.hpp"
+
+#include "keypoint_selection.hpp"
+#include "sift_simd_kernels.hpp"
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/polymorphic.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace openMVG {
+namespace features {
+
+/// HierarchicalGaussianScaleSpace whose Gaussian blurs use the runtime
+/// dispatched sift_simd::GaussianBlur. Same octaves, sigmas and sampling as
+/// the library; the slices only differ by the float accumulation of the blur.
+class SimdGaussianScaleSpace : public Octaver<Octave>
+{
+public:
+  SimdGaussianScaleSpace
+  (
+    const int nb_octave,
+    const int nb_slice,
+    const GaussianScaleSpaceParams & params,
+    sift_simd::SimdLevel level
+  )
+  : Octaver<Octave>(nb_octave, nb_slice),
+    params_(params),
+    level_(level)
+  {}
+
+  void SetImage(const image::Image<float> & img) override
+  {
+    const double sigma_extra =
+      std::sqrt(params_.sigma_min * params_.sigma_min - params_.sigma_in * params_.sigma_in) / params_.delta_min;
+    if (params_.delta_min == 0.5f)
+    {
+      image::Image<float> upsampled;
+      image::ImageUpsample(img, upsampled);
+      sift_simd::GaussianBlur(upsampled, sigma_extra, base_octave_image_, level_);
+    }
+    else
+    {
+      sift_simd::GaussianBlur(img, sigma_extra, base_octave_image_, level_);
+    }
+    // Limit the size of the last octave to be at least 32x32 pixels
+    const int nb_octave_max = static_cast<int>(std::ceil(std::log2(
+      std::min(base_octave_image_.Width(), base_octave_image_.Height()) / 32)));
+    m_nb_octave = std::min(m_nb_octave, nb_octave_max);
+    octave_id_ = 0;
+  }
+
+  bool NextOctave(Octave & octave) override
+  {
+    if (octave_id_ >= m_nb_octave)
+      return false;
+    octave.octave_level = octave_id_;
+    octave.delta = (octave_id_ == 0) ? params_.delta_min : octave.delta * 2.0f;
+
+    const int slice_count = m_nb_slice + params_.supplementary_levels;
+    octave.slices.resize(slice_count);
+    octave.sigmas.resize(slice_count);
+    for (int s = 0; s < slice_count; ++s)
+    {
+      octave.sigmas[s] = octave.delta / params_.delta_min * params_.sigma_min
+        * std::pow(2.0, static_cast<float>(s) / static_cast<float>(m_nb_slice));
+    }
+    octave.slices[0] = base_octave_image_;
+    for (int s = 1; s < slice_count; ++s)
+    {
+      const double sig_prev = octave.sigmas[s - 1];
+      const double sig_next = octave.sigmas[s];
+      const double sigma_extra = std::sqrt(sig_next * sig_next - sig_prev * sig_prev) / octave.delta;
+      sift_simd::GaussianBlur(octave.slices[s - 1], sigma_extra, octave.slices[s], level_);
+    }
+    // Decimate => sigma * 2 for the next octave
+    if (++octave_id_ < m_nb_octave)
+      image::ImageDecimate(octave.slices[m_nb_slice], base_octave_image_);
+    return true;
+  }
+
+private:
+  GaussianScaleSpaceParams params_;
+  sift_simd::SimdLevel level_;
+  image::Image<float> base_octave_image_;
+  int octave_id_ = 0;
+};
+
+/// SIFT_Anatomy describer on the SIMD scale space: the keypoints and the
+/// descriptors are computed by the library extractors on its octaves.
+/// Same parameters, presets and regions (SIFT_Regions) as
+/// SIFT_Anatomy_Image_describer.
+///
+/// The keypoints can be limited and ordered by their detector response (the
+/// absolute DoG value), see SetKeypointSelection.
+class SIFT_Anatomy_SIMD_Image_describer : public SIFT_Anatomy_Image_describer
+{
+public:
+  explicit SIFT_Anatomy_SIMD_Image_describer
+  (
+    const Params & params = Params(),
+    sift_simd::SimdLevel level = sift_simd::ActiveSimdLevel()
+  )
+  : SIFT_Anatomy_Image_describer(params),
+    params_(params),
+    level_(level)
+  {}
+
+  bool Set_configuration_preset(EDESCRIBER_PRESET preset) override
+  {
+    switch (preset)
+    {
+    case NORMAL_PRESET:
+      params_.peak_threshold_ = 0.04f;
+    break;
+    case HIGH_PRESET:
+      params_.peak_threshold_ = 0.01f;
+    break;
+    case ULTRA_PRESET:
+      params_.peak_threshold_ = 0.01f;
+      params_.first_octave_ = -1;
+    break;
+    default:
+      return false;
+    }
+    return SIFT_Anatomy_Image_describer::Set_configuration_preset(preset);
+  }
+
+  /// Keep at most max_count keypoints per image (0: all), spread over the
+  /// image by SelectGridKeypoints with the detector response as score.
+  /// The selection is done before the description: the keypoints of all the
+  /// octaves are detected first, then the scale space is built a second time
+  /// to compute the orientations and descriptors of the kept keypoints only.
+  /// The octaves detected while the running count is under max_count are
+  /// described in the first pass, so the second pass (about the cost of the
+  /// blur) is only paid by the images that have more keypoints than max_count.
+  /// If sort_by_response is set, the regions are ordered by decreasing
+  /// response (the first N regions are the N strongest ones).
+  void SetKeypointSelection(std::size_t max_count, bool sort_by_response)
+  {
+    max_keypoints_ = max_count;
+    sort_by_response_ = sort_by_response;
+  }
+
+  std::unique_ptr<Regions> Describe
+  (
+    const image::Image<unsigned char> & image,
+    const image::Image<unsigned char> * mask = nullptr
+  ) override
+  {
+    auto regions = std::unique_ptr<Regions_type>(new Regions_type);
+    if (image.size() == 0)
+      return std::move(regions);
+
+    // Convert to float in range [0;1]
+    const image::Image<float> If(image.GetMat().cast<float>() / 255.0f);
+
+    // 3 extra slices: +1 for the DoG, +2 for the 3d discrete extrema
+    const int supplementary_images = 3;
+    SimdGaussianScaleSpace octave_gen(
+      params_.num_octaves_,
+      params_.num_scales_,
+      (params_.first_octave_ == -1)
+      ? GaussianScaleSpaceParams(1.6f / 2.0f, 0.5f, 0.5f, supplementary_images)
+      : GaussianScaleSpaceParams(1.6f, 1.0f, 0.5f, supplementary_images),
+      level_);
+
+    // Keypoints of each octave (the masked ones are removed before the
+    // selection, so that they do not use the quota of their cell).
+    // An octave is described right away while the running count cannot
+    // exceed the cap: an image that stays under it is described in one pass.
+    std::vector<std::vector<sift::Keypoint>> octave_keypoints;
+    std::vector<bool> octave_described;
+    std::size_t detected_count = 0;
+    Octave octave;
+    octave_gen.SetImage(If);
+    while (octave_gen.NextOctave(octave))
+    {
+      std::vector<sift::Keypoint> keys;
+      sift::SIFT_KeypointExtractor keypointDetector(
+        params_.peak_threshold_ / octave_gen.NbSlice(),
+        params_.edge_threshold_);
+      keypointDetector(octave, keys);
+      // Feature masking
+      if (mask)
+      {
+        keys.erase(std::remove_if(keys.begin(), keys.end(), [mask](const sift::Keypoint & k)
+        {
+          return (*mask)(static_cast<int>(k.y), static_cast<int>(k.x)) == 0;
+        }), keys.end());
+      }
+      detected_count += keys.size();
+      const bool bDescribe = max_keypoints_ == 0 || detected_count <= max_keypoints_;
+      if (bDescribe)
+      {
+        sift::Sift_DescriptorExtractor descriptorExtractor;
+        descriptorExtractor(octave, keys);
+      }
+      octave_keypoints.push_back(std::move(keys));
+      octave_described.push_back(bDescribe);
+    }
+
+    if (max_keypoints_ > 0 && detected_count > max_keypoints_)
+    {
+      std::vector<sift::Keypoint> keypoints;
+      std::vector<std::size_t> octave_end;
+      for (auto & keys : octave_keypoints)
+      {
+        std::move(keys.begin(), keys.end(), std::back_inserter(keypoints));
+        octave_end.push_back(keypoints.size());
+        keys.clear();
+      }
+      std::size_t octave_id = 0;
+      for (const std::size_t i : SelectKeypointsByResponse(keypoints, image.Width(), image.Height()))
+      {
+        while (i >= octave_end[octave_id])
+          ++octave_id;
+        octave_keypoints[octave_id].push_back(std::move(keypoints[i]));
+      }
+      // Orientations & descriptors of the kept keypoints: the scale space is
+      // built a second time, up to the last octave that still needs them
+      std::size_t octave_count = 0;
+      for (std::size_t id = 0; id < octave_keypoints.size(); ++id)
+      {
+        if (!octave_described[id] && !octave_keypoints[id].empty())
+          octave_count = id + 1;
+      }
+      if (octave_count > 0)
+        octave_gen.SetImage(If);
+      for (octave_id = 0; octave_id < octave_count && octave_gen.NextOctave(octave); ++octave_id)
+      {
+        if (octave_described[octave_id] || octave_keypoints[octave_id].empty())
+          continue;
+        sift::Sift_DescriptorExtractor descriptorExtractor;
+        descriptorExtractor(octave, octave_keypoints[octave_id]);
+      }
+    }
+
+    std::vector<sift::Keypoint> keypoints;
+    for (auto & keys : octave_keypoints)
+      std::move(keys.begin(), keys.end(), std::back_inserter(keypoints));
+    // A keypoint can get several orientations: select again on the described ones
+    std::vector<std::size_t> order(keypoints.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    if (max_keypoints_ > 0 && keypoints.size() > max_keypoints_)
+      order = SelectKeypointsByResponse(keypoints, image.Width(), image.Height());
+    if (sort_by_response_)
+    {
+      std::stable_sort(order.begin(), order.end(), [&keypoints](std::size_t a, std::size_t b)
+      {
+        return std::abs(keypoints[a].val) > std::abs(keypoints[b].val);
+      });
+    }
+    regions->Descriptors().reserve(order.size());
+    regions->Features().reserve(order.size());
+    for (const std::size_t i : order)
+    {
+      const sift::Keypoint & k = keypoints[i];
+      Descriptor<unsigned char, 128> descriptor;
+      descriptor << (k.descr.cast<unsigned char>());
+      regions->Descriptors().emplace_back(descriptor);
+      regions->Features().emplace_back(k.x, k.y, k.sigma, k.theta);
+    }
+    return std::move(regions);
+  }
+
+  sift_simd::SimdLevel Level() const { return level_; }
+
+  template <class Archive>
+  void serialize(Archive & ar)
+  {
+    ar(cereal::make_nvp("params", params_));
+  }
+
+private:
+  /// Indices of the max_keypoints_ kept keypoints, in increasing order
+  std::vector<std::size_t> SelectKeypointsByResponse
+  (
+    const std::vector<sift::Keypoint> & keypoints,
+    int width,
+    int height
+  ) const
+  {
+    std::vector<PointFeature> positions;
+    std::vector<float> responses;
+    positions.reserve(keypoints.size());
+    responses.reserve(keypoints.size());
+    for (const auto & k : keypoints)
+    {
+      positions.emplace_back(k.x, k.y);
+      responses.push_back(std::abs(k.val));
+    }
+    return SelectGridKeypoints(positions, responses, max_keypoints_, width, height);
+  }
+
+  Params params_; // the library describer keeps its parameters private
+  sift_simd::SimdLevel level_;
+  std::size_t max_keypoints_ = 0;
+  bool sort_by_response_ = false;
+};
+
+} // namespace features
+} // namespace openMVG
+
+CEREAL_REGISTER_TYPE_WITH_NAME(openMVG::features::SIFT_Anatomy_SIMD_Image_describer, "SIFT_Anatomy_SIMD_Image_describer");
+CEREAL_REGISTER_POLYMORPHIC_RELATION(openMVG::features::Image_describer, openMVG::features::SIFT_Anatomy_SIMD_Image_describer)
+
+#endif // PRODUCTS_SIFT_ANATOMY_SIMD_DESCRIBER_HPP
@@ -0,0 +1,255 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_SIFT_SIMD_KERNELS_HPP
+#define PRODUCTS_SIFT_SIMD_KERNELS_HPP
+
+#include "openMVG/image/image_container.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PRODUCTS_SIFT_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PRODUCTS_SIFT_SIMD_TARGET_AVX2
+#else
+#define PRODUCTS_SIFT_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+namespace openMVG {
+namespace features {
+
+/// Separable Gaussian blur of the SIFT_Anatomy scale space with an AVX2/FMA
+/// implementation chosen at runtime (CPUID) and a scalar fallback.
+///
+/// The kernel and the borders are those of image::ImageGaussianFilter
+/// (size 2 * 3 * sigma + 1, replicated borders), so the scalar path gives the
+/// library blur. The AVX2 kernels are compiled with a function target
+/// attribute, so the binaries still run on CPUs without AVX2. FMA rounds
+/// once instead of twice: the AVX2 results match the scalar ones up to a few
+/// ulps. OPENMVG_SIMD=scalar forces the scalar path.
+namespace sift_simd {
+
+enum class SimdLevel
+{
+  SCALAR,
+  AVX2_FMA
+};
+
+inline std::string SimdLevelName(SimdLevel level)
+{
+  return level == SimdLevel::AVX2_FMA ? "AVX2/FMA" : "scalar";
+}
+
+/// SIMD level supported by the CPU (and the OS for the AVX state)
+inline SimdLevel DetectCpuSimdLevel()
+{
+#ifdef PRODUCTS_SIFT_SIMD_X86
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return SimdLevel::SCALAR;
+  __cpuid(info, 1);
+  const bool fma = (info[2] & (1 << 12)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  if (!(fma && osxsave && avx) || (_xgetbv(0) & 0x6) != 0x6)
+    return SimdLevel::SCALAR;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) ? SimdLevel::AVX2_FMA : SimdLevel::SCALAR;
+#else
+  __builtin_cpu_init();
+  return (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    ? SimdLevel::AVX2_FMA : SimdLevel::SCALAR;
+#endif
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+/// SIMD level used by the kernels (detected once)
+inline SimdLevel ActiveSimdLevel()
+{
+  static const SimdLevel level = []()
+  {
+    const char * env = std::getenv("OPENMVG_SIMD");
+    if (env && std::string(env) == "scalar")
+      return SimdLevel::SCALAR;
+    return DetectCpuSimdLevel();
+  }();
+  return level;
+}
+
+inline int Clamp(int value, int size)
+{
+  return value < 0 ? 0 : (value >= size ? size - 1 : value);
+}
+
+// -- Scalar kernels
+// A kernel of size taps is centered on tap size / 2 (an even size is not
+// symmetric, as in image::ImageGaussianFilter).
+
+/// out[x] = sum_k kernel[k] * in[clamp(x + k - size / 2)]
+inline void ConvolveRowScalar
+(
+  const float * in, float * out, int width,
+  const float * kernel, int size,
+  int x_begin, int x_end
+)
+{
+  const int half = size / 2;
+  for (int x = x_begin; x < x_end; ++x)
+  {
+    float value = 0.f;
+    for (int k = 0; k < size; ++k)
+      value += kernel[k] * in[Clamp(x + k - half, width)];
+    out[x] = value;
+  }
+}
+
+/// out[x] = sum_k kernel[k] * rows[k][x]
+inline void ConvolveColumnScalar
+(
+  const float * const * rows, float * out, int width,
+  const float * kernel, int size,
+  int x_begin
+)
+{
+  for (int x = x_begin; x < width; ++x)
+  {
+    float value = 0.f;
+    for (int k = 0; k < size; ++k)
+      value += kernel[k] * rows[k][x];
+    out[x] = value;
+  }
+}
+
+// -- AVX2/FMA kernels (8 floats per iteration, scalar tail)
+
+#ifdef PRODUCTS_SIFT_SIMD_X86
+PRODUCTS_SIFT_SIMD_TARGET_AVX2
+inline void ConvolveRowAVX2
+(
+  const float * in, float * out, int width,
+  const float * kernel, int size
+)
+{
+  // Borders (replicated samples) and tail stay scalar
+  const int half = size / 2;
+  const int x_begin = std::min(half, width);
+  const int x_end = std::max(x_begin, width - (size - 1 - half));
+  ConvolveRowScalar(in, out, width, kernel, size, 0, x_begin);
+  int x = x_begin;
+  for (; x + 8 <= x_end; x += 8)
+  {
+    __m256 value = _mm256_setzero_ps();
+    for (int k = 0; k < size; ++k)
+      value = _mm256_fmadd_ps(_mm256_set1_ps(kernel[k]), _mm256_loadu_ps(in + x + k - half), value);
+    _mm256_storeu_ps(out + x, value);
+  }
+  ConvolveRowScalar(in, out, width, kernel, size, x, width);
+}
+
+PRODUCTS_SIFT_SIMD_TARGET_AVX2
+inline void ConvolveColumnAVX2
+(
+  const float * const * rows, float * out, int width,
+  const float * kernel, int size
+)
+{
+  int x = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    __m256 value = _mm256_setzero_ps();
+    for (int k = 0; k < size; ++k)
+      value = _mm256_fmadd_ps(_mm256_set1_ps(kernel[k]), _mm256_loadu_ps(rows[k] + x), value);
+    _mm256_storeu_ps(out + x, value);
+  }
+  ConvolveColumnScalar(rows, out, width, kernel, size, x);
+}
+#endif
+
+// -- Image level functions, dispatched on the SIMD level
+
+/// Normalized Gaussian kernel of image::ImageGaussianFilter (k = 3)
+inline std::vector<float> GaussianKernel(double sigma)
+{
+  const int size = std::max(1, static_cast<int>(2 * 3 * sigma + 1));
+  const int half = size / 2;
+  std::vector<double> weights(size);
+  double sum = 0.0;
+  for (int i = 0; i < size; ++i)
+  {
+    const double dx = i - half;
+    weights[i] = std::exp(-dx * dx / (2.0 * sigma * sigma));
+    sum += weights[i];
+  }
+  std::vector<float> kernel(size);
+  for (int i = 0; i < size; ++i)
+    kernel[i] = static_cast<float>(weights[i] / sum);
+  return kernel;
+}
+
+/// Separable Gaussian blur (border: replicate)
+inline void GaussianBlur
+(
+  const image::Image<float> & in,
+  double sigma,
+  image::Image<float> & out,
+  SimdLevel level = ActiveSimdLevel()
+)
+{
+  const std::vector<float> kernel = GaussianKernel(sigma);
+  const int size = static_cast<int>(kernel.size());
+  const int half = size / 2;
+  const int width = in.Width(), height = in.Height();
+
+  image::Image<float> horizontal(width, height);
+  for (int y = 0; y < height; ++y)
+  {
+    const float * in_row = in.data() + static_cast<size_t>(y) * width;
+    float * out_row = horizontal.data() + static_cast<size_t>(y) * width;
+#ifdef PRODUCTS_SIFT_SIMD_X86
+    if (level == SimdLevel::AVX2_FMA)
+    {
+      ConvolveRowAVX2(in_row, out_row, width, kernel.data(), size);
+      continue;
+    }
+#endif
+    ConvolveRowScalar(in_row, out_row, width, kernel.data(), size, 0, width);
+  }
+
+  out.resize(width, height);
+  std::vector<const float *> rows(size);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int k = 0; k < size; ++k)
+      rows[k] = horizontal.data() + static_cast<size_t>(Clamp(y + k - half, height)) * width;
+    float * out_row = out.data() + static_cast<size_t>(y) * width;
+#ifdef PRODUCTS_SIFT_SIMD_X86
+    if (level == SimdLevel::AVX2_FMA)
+    {
+      ConvolveColumnAVX2(rows.data(), out_row, width, kernel.data(), size);
+      continue;
+    }
+#endif
+    ConvolveColumnScalar(rows.data(), out_row, width, kernel.data(), size, 0);
+  }
+}
+
+} // namespace sift_simd
+} // namespace features
+} // namespace openMVG
+
+#endif // PRODUCTS_SIFT_SIMD_KERNELS_HPP
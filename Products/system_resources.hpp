@@ -0,0 +1,119 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_SYSTEM_RESOURCES_HPP
+#define PRODUCTS_SYSTEM_RESOURCES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace openMVG {
+namespace system {
+
+/// Number of logical cores (at least 1)
+inline unsigned int GetCoreCount()
+{
+  const unsigned int core_count = std::thread::hardware_concurrency();
+  return core_count > 0 ? core_count : 1;
+}
+
+/// Physical memory that can be used without swapping, in bytes (0: unknown).
+/// On Linux the cgroup (container) limit is taken into account.
+inline std::uint64_t GetAvailableMemory()
+{
+#ifdef _WIN32
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if (!::GlobalMemoryStatusEx(&status))
+    return 0;
+  return static_cast<std::uint64_t>(status.ullAvailPhys);
+#else
+  std::uint64_t available = 0;
+  {
+    // MemAvailable also counts the reclaimable page cache
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line))
+    {
+      if (line.compare(0, 13, "MemAvailable:") == 0)
+      {
+        std::istringstream line_stream(line.substr(13));
+        std::uint64_t kilo_bytes = 0;
+        if (line_stream >> kilo_bytes)
+          available = kilo_bytes * 1024;
+        break;
+      }
+    }
+  }
+#ifdef _SC_AVPHYS_PAGES
+  if (available == 0)
+  {
+    const long pages = ::sysconf(_SC_AVPHYS_PAGES);
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0)
+      available = static_cast<std::uint64_t>(pages) * static_cast<std::uint64_t>(page_size);
+  }
+#endif
+  {
+    // cgroup v2 limit ("max" when unlimited)
+    std::ifstream limit_stream("/sys/fs/cgroup/memory.max");
+    std::ifstream usage_stream("/sys/fs/cgroup/memory.current");
+    std::uint64_t limit = 0, usage = 0;
+    if ((limit_stream >> limit) && (usage_stream >> usage))
+    {
+      const std::uint64_t cgroup_available = limit > usage ? limit - usage : 0;
+      available = available > 0 ? std::min(available, cgroup_available) : cgroup_available;
+    }
+  }
+  return available;
+#endif
+}
+
+/// Page faults of the process since its start
+struct PageFaultCounters
+{
+  std::uint64_t minor = 0;  // served without I/O (first touch of a fresh allocation)
+  std::uint64_t major = 0;  // served from the disk
+};
+
+inline PageFaultCounters GetPageFaults()
+{
+  PageFaultCounters counters;
+#ifdef _WIN32
+  // Windows does not split soft and hard faults
+  PROCESS_MEMORY_COUNTERS memory_counters;
+  if (::K32GetProcessMemoryInfo(::GetCurrentProcess(), &memory_counters, sizeof(memory_counters)))
+    counters.minor = memory_counters.PageFaultCount;
+#else
+  struct rusage usage;
+  if (::getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    counters.minor = static_cast<std::uint64_t>(usage.ru_minflt);
+    counters.major = static_cast<std::uint64_t>(usage.ru_majflt);
+  }
+#endif
+  return counters;
+}
+
+} // namespace system
+} // namespace openMVG
+
+#endif // PRODUCTS_SYSTEM_RESOURCES_HPP
@@ -0,0 +1,261 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_VIDEO_FRAME_READER_HPP
+#define PRODUCTS_VIDEO_FRAME_READER_HPP
+
+#include "openMVG/image/image_container.hpp"
+#include "openMVG/image/pixel_types.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char ** environ;
+#endif
+
+namespace openMVG {
+namespace image {
+namespace video_internal {
+
+/// Read end of the standard output of a child process.
+/// The program is started directly with its argument vector (no shell), so
+/// the arguments (i.e a file name with quotes, '$' or backticks) are never
+/// interpreted.
+class ChildProcessOutput
+{
+public:
+  ChildProcessOutput() = default;
+  ChildProcessOutput(const ChildProcessOutput &) = delete;
+  ChildProcessOutput & operator=(const ChildProcessOutput &) = delete;
+  ~ChildProcessOutput() { Close(); }
+
+  /// Start arguments[0] (searched in the PATH) with its arguments
+  bool Open(const std::vector<std::string> & arguments)
+  {
+    Close();
+    if (arguments.empty())
+      return false;
+#ifdef _WIN32
+    SECURITY_ATTRIBUTES security;
+    security.nLength = sizeof(security);
+    security.lpSecurityDescriptor = nullptr;
+    security.bInheritHandle = TRUE;
+    HANDLE read_handle = nullptr, write_handle = nullptr;
+    if (!::CreatePipe(&read_handle, &write_handle, &security, 0))
+      return false;
+    ::SetHandleInformation(read_handle, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA startup_info;
+    std::memset(&startup_info, 0, sizeof(startup_info));
+    startup_info.cb = sizeof(startup_info);
+    startup_info.dwFlags = STARTF_USESTDHANDLES;
+    startup_info.hStdInput = ::GetStdHandle(STD_INPUT_HANDLE);
+    startup_info.hStdOutput = write_handle;
+    startup_info.hStdError = ::GetStdHandle(STD_ERROR_HANDLE);
+    PROCESS_INFORMATION process_info;
+    std::string command_line = QuoteCommandLine(arguments);
+    const bool b_started = ::CreateProcessA(nullptr, &command_line[0], nullptr, nullptr, TRUE,
+                                            0, nullptr, nullptr, &startup_info, &process_info) != 0;
+    ::CloseHandle(write_handle);
+    if (!b_started)
+    {
+      ::CloseHandle(read_handle);
+      return false;
+    }
+    ::CloseHandle(process_info.hThread);
+    process_ = process_info.hProcess;
+    const int fd = ::_open_osfhandle(reinterpret_cast<intptr_t>(read_handle), _O_RDONLY | _O_BINARY);
+    stream_ = (fd >= 0) ? ::_fdopen(fd, "rb") : nullptr;
+#else
+    int fds[2];
+    if (::pipe(fds) != 0)
+      return false;
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+    std::vector<char *> argv;
+    for (const auto & argument : arguments)
+      argv.push_back(const_cast<char *>(argument.c_str()));
+    argv.push_back(nullptr);
+    const bool b_started =
+      ::posix_spawnp(&pid_, argv[0], &actions, nullptr, argv.data(), environ) == 0;
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(fds[1]);
+    if (!b_started)
+    {
+      ::close(fds[0]);
+      pid_ = -1;
+      return false;
+    }
+    stream_ = ::fdopen(fds[0], "r");
+    if (!stream_)
+      ::close(fds[0]);
+#endif
+    if (!stream_)
+    {
+      Close();
+      return false;
+    }
+    return true;
+  }
+
+  /// Close the pipe and wait for the child process.
+  /// Return true if the process exited normally with a zero status.
+  bool Close()
+  {
+    if (stream_)
+      std::fclose(stream_);
+    stream_ = nullptr;
+    bool b_success = false;
+#ifdef _WIN32
+    if (process_)
+    {
+      ::WaitForSingleObject(process_, INFINITE);
+      DWORD exit_code = 1;
+      b_success = ::GetExitCodeProcess(process_, &exit_code) && exit_code == 0;
+      ::CloseHandle(process_);
+    }
+    process_ = nullptr;
+#else
+    if (pid_ > 0)
+    {
+      int status = 0;
+      while (::waitpid(pid_, &status, 0) < 0 && errno == EINTR) {}
+      b_success = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    pid_ = -1;
+#endif
+    return b_success;
+  }
+
+  FILE * stream() const { return stream_; }
+
+private:
+#ifdef _WIN32
+  /// Command line parsed back to the same argv by the MSVC runtime
+  static std::string QuoteCommandLine(const std::vector<std::string> & arguments)
+  {
+    std::string command_line;
+    for (const auto & argument : arguments)
+    {
+      if (!command_line.empty())
+        command_line += ' ';
+      command_line += '"';
+      std::size_t backslashes = 0;
+      for (const char c : argument)
+      {
+        if (c == '\\')
+        {
+          ++backslashes;
+          continue;
+        }
+        // Backslashes are only special before a quote
+        command_line.append(c == '"' ? 2 * backslashes + 1 : backslashes, '\\');
+        backslashes = 0;
+        command_line += c;
+      }
+      command_line.append(2 * backslashes, '\\');
+      command_line += '"';
+    }
+    return command_line;
+  }
+
+  HANDLE process_ = nullptr;
+#else
+  pid_t pid_ = -1;
+#endif
+  FILE * stream_ = nullptr;
+};
+
+} // namespace video_internal
+
+/// Sequential RGB frame reader of a local video file.
+/// The frames are decoded by an external ffmpeg process and streamed through
+/// a pipe as raw rgb24 data, so no frame is ever written to the disk.
+/// ffprobe & ffmpeg must be in the PATH.
+///
+/// The frames are read in their coded orientation (-noautorotate): ffprobe
+/// reports the coded size, while ffmpeg would otherwise rotate the frames of
+/// phone videos carrying a rotation and the frame size would not match.
+class VideoFrameReader
+{
+public:
+  VideoFrameReader() = default;
+  VideoFrameReader(const VideoFrameReader &) = delete;
+  VideoFrameReader & operator=(const VideoFrameReader &) = delete;
+  ~VideoFrameReader() { Close(); }
+
+  bool Open(const std::string & sVideoFilename)
+  {
+    Close();
+    // Frame size of the first video stream
+    {
+      video_internal::ChildProcessOutput probe;
+      if (!probe.Open({"ffprobe", "-v", "error", "-select_streams", "v:0",
+                       "-show_entries", "stream=width,height", "-of", "csv=p=0:s=x",
+                       "-i", sVideoFilename}))
+        return false;
+      const int read_count = std::fscanf(probe.stream(), "%dx%d", &width_, &height_);
+      probe.Close();
+      if (read_count != 2 || width_ <= 0 || height_ <= 0)
+      {
+        width_ = height_ = 0;
+        return false;
+      }
+    }
+
+    if (!decoder_.Open({"ffmpeg", "-v", "error", "-noautorotate", "-i", sVideoFilename,
+                        "-map", "0:v:0", "-an", "-f", "rawvideo", "-pix_fmt", "rgb24", "-"}))
+      return false;
+    buffer_.resize(static_cast<std::size_t>(width_) * height_ * 3);
+    return true;
+  }
+
+  void Close()
+  {
+    decoder_.Close();
+  }
+
+  /// Read the next frame, return false at the end of the video
+  bool Read(Image<RGBColor> & frame)
+  {
+    FILE * stream = decoder_.stream();
+    if (!stream || std::fread(buffer_.data(), 1, buffer_.size(), stream) != buffer_.size())
+      return false;
+    frame.resize(width_, height_);
+    std::memcpy(frame.data(), buffer_.data(), buffer_.size());
+    return true;
+  }
+
+  int Width() const { return width_; }
+  int Height() const { return height_; }
+
+private:
+  video_internal::ChildProcessOutput decoder_;
+  int width_ = 0, height_ = 0;
+  std::vector<unsigned char> buffer_;
+};
+
+} // namespace image
+} // namespace openMVG
+
+#endif // PRODUCTS_VIDEO_FRAME_READER_HPP
@@ -0,0 +1,314 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_VIDEO_KEYFRAME_SELECTOR_HPP
+#define PRODUCTS_VIDEO_KEYFRAME_SELECTOR_HPP
+
+#include "openMVG/image/image_container.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace openMVG {
+namespace image {
+
+/// Sparse pyramidal Lucas-Kanade tracker working on small grayscale frames
+class SparseFlowTracker
+{
+public:
+  struct Point
+  {
+    float x, y;
+  };
+
+  SparseFlowTracker
+  (
+    int pyramid_levels = 3,
+    int window_radius = 3
+  ): pyramid_levels_(std::max(1, pyramid_levels)), window_radius_(std::max(1, window_radius))
+  {}
+
+  /// Build the pyramid of a frame
+  void BuildPyramid
+  (
+    const Image<unsigned char> & frame,
+    std::vector<Image<float>> & pyramid
+  ) const
+  {
+    pyramid.resize(pyramid_levels_);
+    pyramid[0].resize(frame.Width(), frame.Height());
+    for (int y = 0; y < frame.Height(); ++y)
+      for (int x = 0; x < frame.Width(); ++x)
+        pyramid[0](y, x) = frame(y, x);
+    for (int level = 1; level < pyramid_levels_; ++level)
+    {
+      const Image<float> & fine = pyramid[level - 1];
+      Image<float> & coarse = pyramid[level];
+      coarse.resize(std::max(1, fine.Width() / 2), std::max(1, fine.Height() / 2));
+      for (int y = 0; y < coarse.Height(); ++y)
+        for (int x = 0; x < coarse.Width(); ++x)
+        {
+          const int x0 = std::min(2 * x, fine.Width() - 1), x1 = std::min(2 * x + 1, fine.Width() - 1);
+          const int y0 = std::min(2 * y, fine.Height() - 1), y1 = std::min(2 * y + 1, fine.Height() - 1);
+          coarse(y, x) = 0.25f * (fine(y0, x0) + fine(y0, x1) + fine(y1, x0) + fine(y1, x1));
+        }
+    }
+  }
+
+  /// Select up to grid_cols x grid_rows well textured points (Shi-Tomasi
+  /// score, best point of each grid cell)
+  std::vector<Point> DetectPoints
+  (
+    const Image<float> & frame,
+    int grid_cols = 16,
+    int grid_rows = 12,
+    float min_score = 25.f
+  ) const
+  {
+    std::vector<Point> points;
+    const int border = window_radius_ + 1;
+    const int w = frame.Width(), h = frame.Height();
+    for (int row = 0; row < grid_rows; ++row)
+    {
+      for (int col = 0; col < grid_cols; ++col)
+      {
+        const int x_begin = std::max(border, col * w / grid_cols);
+        const int x_end = std::min(w - border, (col + 1) * w / grid_cols);
+        const int y_begin = std::max(border, row * h / grid_rows);
+        const int y_end = std::min(h - border, (row + 1) * h / grid_rows);
+        float best_score = min_score;
+        Point best_point{-1.f, -1.f};
+        for (int y = y_begin; y < y_end; ++y)
+          for (int x = x_begin; x < x_end; ++x)
+          {
+            const float score = MinEigenValue(frame, x, y);
+            if (score > best_score)
+            {
+              best_score = score;
+              best_point = {static_cast<float>(x), static_cast<float>(y)};
+            }
+          }
+        if (best_point.x >= 0.f)
+          points.push_back(best_point);
+      }
+    }
+    return points;
+  }
+
+  /// Track the points from the previous to the current pyramid.
+  /// Return for each point if it was tracked (its position is then updated).
+  std::vector<bool> Track
+  (
+    const std::vector<Image<float>> & previous,
+    const std::vector<Image<float>> & current,
+    std::vector<Point> & points,
+    float max_residual = 20.f
+  ) const
+  {
+    std::vector<bool> tracked(points.size(), false);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      float dx = 0.f, dy = 0.f;
+      bool b_ok = true;
+      for (int level = pyramid_levels_ - 1; level >= 0 && b_ok; --level)
+      {
+        const float scale = 1.f / static_cast<float>(1 << level);
+        b_ok = TrackLevel(previous[level], current[level],
+          points[i].x * scale, points[i].y * scale, dx, dy);
+        if (level > 0)
+        {
+          dx *= 2.f;
+          dy *= 2.f;
+        }
+      }
+      const Point moved{points[i].x + dx, points[i].y + dy};
+      const Image<float> & fine = current[0];
+      if (!b_ok || moved.x < 0.f || moved.y < 0.f
+          || moved.x > fine.Width() - 1.f || moved.y > fine.Height() - 1.f
+          || Residual(previous[0], current[0], points[i], moved) > max_residual)
+        continue;
+      points[i] = moved;
+      tracked[i] = true;
+    }
+    return tracked;
+  }
+
+private:
+  static float Sample(const Image<float> & image, float x, float y)
+  {
+    x = std::min(std::max(x, 0.f), image.Width() - 1.001f);
+    y = std::min(std::max(y, 0.f), image.Height() - 1.001f);
+    const int x0 = static_cast<int>(x), y0 = static_cast<int>(y);
+    const float ax = x - x0, ay = y - y0;
+    return (1.f - ay) * ((1.f - ax) * image(y0, x0) + ax * image(y0, x0 + 1))
+      + ay * ((1.f - ax) * image(y0 + 1, x0) + ax * image(y0 + 1, x0 + 1));
+  }
+
+  float MinEigenValue(const Image<float> & image, int x, int y) const
+  {
+    float gxx = 0.f, gxy = 0.f, gyy = 0.f;
+    for (int j = -1; j <= 1; ++j)
+      for (int i = -1; i <= 1; ++i)
+      {
+        const float ix = 0.5f * (image(y + j, x + i + 1) - image(y + j, x + i - 1));
+        const float iy = 0.5f * (image(y + j + 1, x + i) - image(y + j - 1, x + i));
+        gxx += ix * ix;
+        gxy += ix * iy;
+        gyy += iy * iy;
+      }
+    return 0.5f * (gxx + gyy - std::sqrt((gxx - gyy) * (gxx - gyy) + 4.f * gxy * gxy));
+  }
+
+  /// Refine the displacement (dx, dy) of the point (x, y) at one pyramid level
+  bool TrackLevel
+  (
+    const Image<float> & previous,
+    const Image<float> & current,
+    float x,
+    float y,
+    float & dx,
+    float & dy
+  ) const
+  {
+    const int side = 2 * window_radius_ + 1;
+    std::vector<float> templ(side * side), grad_x(side * side), grad_y(side * side);
+    float gxx = 0.f, gxy = 0.f, gyy = 0.f;
+    for (int j = -window_radius_, k = 0; j <= window_radius_; ++j)
+      for (int i = -window_radius_; i <= window_radius_; ++i, ++k)
+      {
+        templ[k] = Sample(previous, x + i, y + j);
+        grad_x[k] = 0.5f * (Sample(previous, x + i + 1, y + j) - Sample(previous, x + i - 1, y + j));
+        grad_y[k] = 0.5f * (Sample(previous, x + i, y + j + 1) - Sample(previous, x + i, y + j - 1));
+        gxx += grad_x[k] * grad_x[k];
+        gxy += grad_x[k] * grad_y[k];
+        gyy += grad_y[k] * grad_y[k];
+      }
+    const float det = gxx * gyy - gxy * gxy;
+    if (det < 1e-3f)
+      return false;
+
+    for (int iteration = 0; iteration < 10; ++iteration)
+    {
+      float bx = 0.f, by = 0.f;
+      for (int j = -window_radius_, k = 0; j <= window_radius_; ++j)
+        for (int i = -window_radius_; i <= window_radius_; ++i, ++k)
+        {
+          const float diff = templ[k] - Sample(current, x + dx + i, y + dy + j);
+          bx += diff * grad_x[k];
+          by += diff * grad_y[k];
+        }
+      const float step_x = (gyy * bx - gxy * by) / det;
+      const float step_y = (gxx * by - gxy * bx) / det;
+      dx += step_x;
+      dy += step_y;
+      if (step_x * step_x + step_y * step_y < 1e-4f)
+        break;
+    }
+    return std::isfinite(dx) && std::isfinite(dy);
+  }
+
+  /// Mean absolute difference between the windows around p & q
+  float Residual
+  (
+    const Image<float> & previous,
+    const Image<float> & current,
+    const Point & p,
+    const Point & q
+  ) const
+  {
+    float sum = 0.f;
+    for (int j = -window_radius_; j <= window_radius_; ++j)
+      for (int i = -window_radius_; i <= window_radius_; ++i)
+        sum += std::abs(Sample(previous, p.x + i, p.y + j) - Sample(current, q.x + i, q.y + j));
+    const int side = 2 * window_radius_ + 1;
+    return sum / (side * side);
+  }
+
+  int pyramid_levels_;
+  int window_radius_;
+};
+
+/// Select the keyframes of a video stream by parallax.
+/// Points are tracked from the last keyframe; a frame becomes a keyframe when
+/// the median displacement of the tracked points reaches min_parallax (ratio
+/// of the frame size) or when too many tracks are lost.
+class VideoKeyframeSelector
+{
+public:
+  VideoKeyframeSelector
+  (
+    double min_parallax = 0.05,
+    double min_tracked_ratio = 0.5
+  ): min_parallax_(min_parallax), min_tracked_ratio_(min_tracked_ratio)
+  {}
+
+  /// Feed the next (downscaled grayscale) frame, return true for a keyframe
+  bool AddFrame(const Image<unsigned char> & frame)
+  {
+    tracker_.BuildPyramid(frame, current_);
+    bool b_keyframe = previous_.empty();
+    if (!b_keyframe && points_.empty())
+    {
+      // Nothing was detected on the last keyframe (i.e a black fade-in):
+      // there is nothing to track, so restart on the first textured frame.
+      points_ = tracker_.DetectPoints(current_[0]);
+      origins_ = points_;
+      detected_count_ = points_.size();
+      std::swap(previous_, current_);
+      return !points_.empty();
+    }
+    if (!b_keyframe)
+    {
+      const std::vector<bool> tracked = tracker_.Track(previous_, current_, points_);
+      std::vector<SparseFlowTracker::Point> points;
+      std::vector<SparseFlowTracker::Point> origins;
+      std::vector<double> displacements;
+      for (std::size_t i = 0; i < points_.size(); ++i)
+      {
+        if (!tracked[i])
+          continue;
+        points.push_back(points_[i]);
+        origins.push_back(origins_[i]);
+        displacements.push_back(std::hypot(points_[i].x - origins_[i].x, points_[i].y - origins_[i].y));
+      }
+      points_.swap(points);
+      origins_.swap(origins);
+
+      double parallax = 0.0;
+      if (!displacements.empty())
+      {
+        std::nth_element(displacements.begin(),
+          displacements.begin() + displacements.size() / 2, displacements.end());
+        parallax = displacements[displacements.size() / 2]
+          / std::max(frame.Width(), frame.Height());
+      }
+      b_keyframe = parallax >= min_parallax_
+        || points_.size() < min_tracked_ratio_ * detected_count_;
+    }
+    if (b_keyframe)
+    {
+      points_ = tracker_.DetectPoints(current_[0]);
+      origins_ = points_;
+      detected_count_ = points_.size();
+    }
+    std::swap(previous_, current_);
+    return b_keyframe;
+  }
+
+private:
+  double min_parallax_;
+  double min_tracked_ratio_;
+  SparseFlowTracker tracker_;
+  std::vector<Image<float>> previous_, current_;
+  std::vector<SparseFlowTracker::Point> points_, origins_;
+  std::size_t detected_count_ = 0;
+};
+
+} // namespace image
+} // namespace openMVG
+
+#endif // PRODUCTS_VIDEO_KEYFRAME_SELECTOR_HPP
@@ -0,0 +1,75 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_VIEW_ID_PAIRS_HPP
+#define PRODUCTS_VIEW_ID_PAIRS_HPP
+
+#include "openMVG/sfm/sfm_data.hpp"
+#include "openMVG/types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace openMVG {
+namespace sfm {
+
+/// Pair builders working on the actual view ids of a scene.
+///
+/// The view ids of an incrementally listed scene are not [0, N): the images
+/// listed before keep their id, new images get ids after the previous
+/// maximum and removed images leave gaps. exhaustivePairs(N),
+/// contiguousWithOverlap(N, X) and the "N" of loadPairs assume [0, N).
+
+/// Sorted view ids of a scene
+inline std::vector<IndexT> SortedViewIds(const SfM_Data & sfm_data)
+{
+  std::vector<IndexT> view_ids;
+  view_ids.reserve(sfm_data.GetViews().size());
+  for (const auto & view_it : sfm_data.GetViews())
+    view_ids.push_back(view_it.first);
+  std::sort(view_ids.begin(), view_ids.end());
+  return view_ids;
+}
+
+/// Max view id + 1: the image count expected by loadPairs, getGraphStatistics
+/// and PairWiseMatchingToAdjacencyMatrixSVG
+inline std::size_t ViewIdBound(const std::vector<IndexT> & view_ids)
+{
+  return view_ids.empty() ? 0 : static_cast<std::size_t>(*std::max_element(view_ids.cbegin(), view_ids.cend())) + 1;
+}
+
+/// Pairs of each view with the next contiguous_count views of ordered_view_ids
+/// (i.e ids sorted by image name for a video). Pairs are stored as (min, max).
+inline Pair_Set ContiguousViewPairs
+(
+  const std::vector<IndexT> & ordered_view_ids,
+  std::size_t contiguous_count
+)
+{
+  Pair_Set pairs;
+  const std::size_t view_count = ordered_view_ids.size();
+  for (std::size_t i = 0; i < view_count; ++i)
+  {
+    for (std::size_t j = i + 1; j < view_count && j <= i + contiguous_count; ++j)
+    {
+      pairs.insert({std::min(ordered_view_ids[i], ordered_view_ids[j]),
+                    std::max(ordered_view_ids[i], ordered_view_ids[j])});
+    }
+  }
+  return pairs;
+}
+
+/// All the pairs of views
+inline Pair_Set ExhaustiveViewPairs(const std::vector<IndexT> & view_ids)
+{
+  return ContiguousViewPairs(view_ids, view_ids.size());
+}
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_VIEW_ID_PAIRS_HPP
@@ -0,0 +1,283 @@
+// This file is part of OpenMVG, an Open Multiple View Geometry C++ library.
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PRODUCTS_VIEW_POSITION_INDEX_HPP
+#define PRODUCTS_VIEW_POSITION_INDEX_HPP
+
+#include "openMVG/numeric/eigen_alias_definition.hpp"
+#include "openMVG/numeric/numeric.h"
+#include "openMVG/types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openMVG {
+namespace geodesy {
+
+/// Batch WGS84 conversion of (latitude, longitude, altitude) columns
+/// (degrees, degrees, meters) to ECEF coordinates (meters)
+inline Mat3X LlaToEcef(const Mat3X & lla)
+{
+  const double a = 6378137.0;              // semi-major axis
+  const double e2 = 6.69437999014e-3;      // first eccentricity squared
+  const Eigen::ArrayXd lat = lla.row(0).transpose().array() * D2R(1.0);
+  const Eigen::ArrayXd lon = lla.row(1).transpose().array() * D2R(1.0);
+  const Eigen::ArrayXd alt = lla.row(2).transpose().array();
+  const Eigen::ArrayXd sin_lat = lat.sin(), cos_lat = lat.cos();
+  const Eigen::ArrayXd n = a / (1.0 - e2 * sin_lat.square()).sqrt();
+  Mat3X ecef(3, lla.cols());
+  ecef.row(0) = ((n + alt) * cos_lat * lon.cos()).matrix().transpose();
+  ecef.row(1) = ((n + alt) * cos_lat * lon.sin()).matrix().transpose();
+  ecef.row(2) = ((n * (1.0 - e2) + alt) * sin_lat).matrix().transpose();
+  return ecef;
+}
+
+/// Batch conversion of ECEF columns to the local East North Up frame
+/// tangent at the origin (latitude, longitude, altitude)
+inline Mat3X EcefToEnu(const Mat3X & ecef, const Vec3 & lla_origin)
+{
+  const double lat = D2R(lla_origin(0)), lon = D2R(lla_origin(1));
+  Mat3 R;
+  R << -std::sin(lon),                 std::cos(lon),                0.0,
+       -std::sin(lat) * std::cos(lon), -std::sin(lat) * std::sin(lon), std::cos(lat),
+        std::cos(lat) * std::cos(lon),  std::cos(lat) * std::sin(lon), std::sin(lat);
+  const Vec3 origin = LlaToEcef(lla_origin);
+  return R * (ecef.colwise() - origin);
+}
+
+} // namespace geodesy
+
+namespace sfm {
+
+namespace view_position_index_internal {
+
+static const char kMagic[8] = {'O', 'M', 'V', 'G', 'V', 'P', 'O', 'S'};
+static const std::uint32_t kVersion = 1;
+
+} // namespace view_position_index_internal
+
+/// Compact spatial index of view positions (e.g. GPS priors), stored as:
+///   "OMVGVPOS" | uint32 version | uint32 count | double cell size
+///   count x {uint32 view id, double x, y, z} sorted by grid cell
+/// A uniform grid is rebuilt on load to answer neighbour queries.
+class ViewPositionIndex
+{
+public:
+  void Build(const std::vector<std::pair<IndexT, Vec3>> & positions)
+  {
+    entries_.clear();
+    entries_.reserve(positions.size());
+    for (const auto & position : positions)
+      entries_.push_back({position.first, position.second});
+
+    // Cell size: about one cell per point along each axis of the bounding box.
+    // The box spans the 5th to 95th percentiles, so that a single wrong GPS
+    // fix far away does not inflate the cells and put every view in one cell.
+    cell_size_ = 1.0;
+    if (!entries_.empty())
+    {
+      double extent = 0.0;
+      std::vector<double> coordinates(entries_.size());
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        for (std::size_t i = 0; i < entries_.size(); ++i)
+          coordinates[i] = entries_[i].position(axis);
+        const auto low = coordinates.begin() + coordinates.size() / 20;
+        const auto high = coordinates.begin() + (coordinates.size() - 1 - coordinates.size() / 20);
+        std::nth_element(coordinates.begin(), low, coordinates.end());
+        const double low_value = *low;
+        std::nth_element(coordinates.begin(), high, coordinates.end());
+        extent = std::max(extent, *high - low_value);
+      }
+      const double cells_per_axis = std::max(1.0, std::round(std::cbrt(static_cast<double>(entries_.size()))));
+      if (extent > 0.0)
+        cell_size_ = extent / cells_per_axis;
+    }
+    std::sort(entries_.begin(), entries_.end(),
+      [this](const Entry & a, const Entry & b)
+      {
+        return std::make_pair(Cell(a.position), a.id) < std::make_pair(Cell(b.position), b.id);
+      });
+    BuildGrid();
+  }
+
+  bool Save(const std::string & filename) const
+  {
+    using namespace view_position_index_internal;
+    std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!stream)
+      return false;
+    const std::uint32_t version = kVersion, count = static_cast<std::uint32_t>(entries_.size());
+    stream.write(kMagic, sizeof(kMagic));
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    stream.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    stream.write(reinterpret_cast<const char *>(&cell_size_), sizeof(cell_size_));
+    for (const auto & entry : entries_)
+    {
+      const std::uint32_t id = entry.id;
+      stream.write(reinterpret_cast<const char *>(&id), sizeof(id));
+      stream.write(reinterpret_cast<const char *>(entry.position.data()), 3 * sizeof(double));
+    }
+    return static_cast<bool>(stream);
+  }
+
+  bool Load(const std::string & filename)
+  {
+    using namespace view_position_index_internal;
+    entries_.clear();
+    grid_.clear();
+    std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+    char magic[sizeof(kMagic)];
+    std::uint32_t version = 0, count = 0;
+    if (!stream.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0
+        || !stream.read(reinterpret_cast<char *>(&version), sizeof(version)) || version != kVersion
+        || !stream.read(reinterpret_cast<char *>(&count), sizeof(count))
+        || !stream.read(reinterpret_cast<char *>(&cell_size_), sizeof(cell_size_)))
+      return false;
+    entries_.resize(count);
+    for (auto & entry : entries_)
+    {
+      std::uint32_t id = 0;
+      if (!stream.read(reinterpret_cast<char *>(&id), sizeof(id))
+          || !stream.read(reinterpret_cast<char *>(entry.position.data()), 3 * sizeof(double)))
+      {
+        entries_.clear();
+        return false;
+      }
+      entry.id = id;
+    }
+    BuildGrid();
+    return true;
+  }
+
+  std::size_t size() const { return entries_.size(); }
+
+  /// Visit the view ids & positions
+  template <typename Functor>
+  void ForEach(Functor functor) const
+  {
+    for (const auto & entry : entries_)
+      functor(entry.id, entry.position);
+  }
+
+  /// The k views closest to a position (the view at query_id is excluded)
+  std::vector<IndexT> Nearest
+  (
+    const Vec3 & position,
+    std::size_t k,
+    IndexT query_id = UndefinedIndexT
+  ) const
+  {
+    std::vector<std::pair<double, IndexT>> candidates;
+    if (k == 0 || entries_.empty())
+      return {};
+    const CellKey center = Cell(position);
+    // Visit the grid by growing shells of cells, until the k-th candidate is
+    // closer than any point of the next shell
+    for (int ring = 0; ; ++ring)
+    {
+      // Once the shells hold many more cells than there are occupied cells
+      // (too few views, or far outliers), a linear scan is cheaper
+      const double side = 2.0 * ring + 1.0;
+      if (side * side * side > 8.0 * grid_.size() + 27.0)
+      {
+        candidates.clear();
+        for (const auto & entry : entries_)
+        {
+          if (entry.id != query_id)
+            candidates.emplace_back((entry.position - position).squaredNorm(), entry.id);
+        }
+        break;
+      }
+      for (int dx = -ring; dx <= ring; ++dx)
+        for (int dy = -ring; dy <= ring; ++dy)
+          for (int dz = -ring; dz <= ring; ++dz)
+          {
+            if (std::max(std::abs(dx), std::max(std::abs(dy), std::abs(dz))) != ring)
+              continue; // inner cells were visited by the previous rings
+            const auto it = grid_.find(CellKey{std::get<0>(center) + dx,
+              std::get<1>(center) + dy, std::get<2>(center) + dz});
+            if (it == grid_.cend())
+              continue;
+            for (std::size_t i = it->second.first; i < it->second.second; ++i)
+            {
+              if (entries_[i].id != query_id)
+                candidates.emplace_back((entries_[i].position - position).squaredNorm(), entries_[i].id);
+            }
+          }
+      if (candidates.size() >= k)
+      {
+        std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+        const double reach = ring * cell_size_;
+        if (candidates[k - 1].first <= reach * reach)
+          break;
+      }
+    }
+    k = std::min(k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+    std::vector<IndexT> neighbors;
+    for (std::size_t i = 0; i < k; ++i)
+      neighbors.push_back(candidates[i].second);
+    return neighbors;
+  }
+
+private:
+  using CellKey = std::tuple<std::int64_t, std::int64_t, std::int64_t>;
+
+  struct CellKeyHash
+  {
+    std::size_t operator()(const CellKey & key) const
+    {
+      return static_cast<std::size_t>(std::get<0>(key) * 73856093
+        ^ std::get<1>(key) * 19349663 ^ std::get<2>(key) * 83492791);
+    }
+  };
+
+  struct Entry
+  {
+    IndexT id;
+    Vec3 position;
+  };
+
+  CellKey Cell(const Vec3 & position) const
+  {
+    return CellKey{static_cast<std::int64_t>(std::floor(position(0) / cell_size_)),
+      static_cast<std::int64_t>(std::floor(position(1) / cell_size_)),
+      static_cast<std::int64_t>(std::floor(position(2) / cell_size_))};
+  }
+
+  /// Entries are sorted by cell: store the range of each cell
+  void BuildGrid()
+  {
+    grid_.clear();
+    for (std::size_t i = 0; i < entries_.size(); )
+    {
+      const CellKey key = Cell(entries_[i].position);
+      std::size_t end = i + 1;
+      while (end < entries_.size() && Cell(entries_[end].position) == key)
+        ++end;
+      grid_[key] = {i, end};
+      i = end;
+    }
+  }
+
+  double cell_size_ = 1.0;
+  std::vector<Entry> entries_;
+  std::unordered_map<CellKey, std::pair<std::size_t, std::size_t>, CellKeyHash> grid_;
+};
+
+} // namespace sfm
+} // namespace openMVG
+
+#endif // PRODUCTS_VIEW_POSITION_INDEX_HPP